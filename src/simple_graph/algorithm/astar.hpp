@@ -1,92 +1,112 @@
 #pragma once
 
-#include <functional>
-#include <set>
-#include <unordered_set>
+#include <algorithm>
+#include <vector>
 #include "simple_graph/graph.hpp"
+#include "simple_graph/graph_traits.hpp"
+#include "simple_graph/indexed_heap.hpp"
+#include "simple_graph/search_context.hpp"
 
 namespace simple_graph {
 
-vertex_index_t min_idx(const std::unordered_set<vertex_index_t> &opened, const std::vector<float> &f_score)
+/**
+ * Context of A* algorithm, open set is kept in an indexed heap of the specified arity.
+ */
+template<size_t Arity = 4>
+using AstarContext = SearchContext<float, IndexedHeap<float, Arity>>;
+
+/**
+ * Find path between two vertices with A* algorithm reusing search state.
+ *
+ * @tparam Arity Arity of the heap used for the open set, 2 for binary heap, 4 for 4-ary heap etc.
+ * @param g Graph to search in.
+ * @param start_idx Start vertex index.
+ * @param goal_idx Goal vertex index.
+ * @param heuristic Callable estimating distance between two vertices, must not overestimate.
+ * @param path Found path from start to goal.
+ * @param context Search state, reset at the start of the search.
+ * @return True if path was found, false otherwise.
+ */
+template<size_t Arity = 4, typename G, typename H>
+enable_if_graph_t<G, bool> astar(const G &g, vertex_index_t start_idx, vertex_index_t goal_idx,
+        const H &heuristic,
+        std::vector<vertex_index_t> *path, AstarContext<Arity> *context)
 {
-    vertex_index_t min_idx = 0;
+    vertex_index_t vnum = vertex_bound(g);
 
-    float min = std::numeric_limits<float>::max();
-    bool inited = false;
-    for (auto idx : opened) {
-        if ((f_score[idx] < min) || !inited) {
-            min_idx = idx;
-            min = f_score[idx];
-            inited = true;
-        }
-    }
-
-    return min_idx;
-}
-
-template<bool Dir, typename V, typename E, typename W>
-bool astar(const Graph<Dir, V, E, W> &g, vertex_index_t start_idx, vertex_index_t goal_idx,
-        const std::function<float(simple_graph::vertex_index_t, simple_graph::vertex_index_t)> &heuristic,
-        std::vector<vertex_index_t> *path)
-{
-    vertex_index_t vnum = g.vertex_num();
-
-    if ((start_idx > vnum) || (goal_idx > vnum)) {
+    if ((start_idx < 0) || (goal_idx < 0) || (start_idx >= vnum) || (goal_idx >= vnum)) {
         return false;
     }
 
-    std::unordered_set<vertex_index_t> closed;
-    std::unordered_set<vertex_index_t> opened;
-    std::vector<vertex_index_t> came_from(vnum, 0);
-    std::vector<float> g_score(vnum, std::numeric_limits<float>::max());
-    std::vector<float> f_score(vnum, std::numeric_limits<float>::max());
-
-    g_score[start_idx] = 0;
-    f_score[start_idx] = heuristic(start_idx, goal_idx);
+    context->reset(vnum);
+    auto &opened = context->queue();
+    opened.reserve(vnum);
 
-    opened.insert(start_idx);
+    context->set_distance(start_idx, 0);
+    opened.push(start_idx, heuristic(start_idx, goal_idx));
 
     bool vertex_found = false;
     while (!vertex_found && !opened.empty()) {
-        vertex_index_t current = min_idx(opened, f_score);
+        vertex_index_t current = opened.pop();
         if (current == goal_idx) {
             vertex_found = true;
             break;
         }
-        opened.erase(current);
-        closed.insert(current);
+        context->visit(current);
 
-        const std::set<vertex_index_t> &neighbours = g.outbounds(current, 0);
-        for (const auto &neighbour : neighbours) {
-            if (closed.count(neighbour) > 0) {
+        float current_score = context->distance(current);
+        for (const auto &n : g.out_neighbours(current, 0)) {
+            vertex_index_t neighbour = n.idx;
+            if (context->visited(neighbour)) {
                 continue;
             }
 
-            float tentative_score = g_score[current] + g.edge(current, neighbour).weight();
-            if (opened.count(neighbour) == 0) {
-                opened.insert(neighbour);
-            }
-            else if (tentative_score >= g_score[neighbour]) {
+            float tentative_score = current_score + n.weight;
+            bool is_opened = opened.contains(neighbour);
+            if (is_opened && (tentative_score >= context->distance(neighbour))) {
                 continue;
             }
 
-            came_from[neighbour] = current;
-            g_score[neighbour] = tentative_score;
-            f_score[neighbour] = g_score[neighbour] + heuristic(neighbour, goal_idx);
+            context->set_predecessor(neighbour, current);
+            context->set_distance(neighbour, tentative_score);
+            float f_score = tentative_score + heuristic(neighbour, goal_idx);
+            if (is_opened) {
+                opened.decrease(neighbour, f_score);
+            }
+            else {
+                opened.push(neighbour, f_score);
+            }
         }
     }
 
     if (vertex_found) {
-        vertex_index_t idx = goal_idx;
-        do {
+        for (vertex_index_t idx = goal_idx; idx != -1; idx = context->predecessor(idx)) {
             path->push_back(idx);
-            idx = came_from[idx];
-        } while (idx != start_idx);
-        path->push_back(idx);
+        }
         std::reverse(path->begin(), path->end());
     }
 
     return vertex_found;
 }
 
+/**
+ * Find path between two vertices with A* algorithm.
+ *
+ * @tparam Arity Arity of the heap used for the open set, 2 for binary heap, 4 for 4-ary heap etc.
+ * @param g Graph to search in.
+ * @param start_idx Start vertex index.
+ * @param goal_idx Goal vertex index.
+ * @param heuristic Callable estimating distance between two vertices, must not overestimate.
+ * @param path Found path from start to goal.
+ * @return True if path was found, false otherwise.
+ */
+template<size_t Arity = 4, typename G, typename H>
+enable_if_graph_t<G, bool> astar(const G &g, vertex_index_t start_idx, vertex_index_t goal_idx,
+        const H &heuristic,
+        std::vector<vertex_index_t> *path)
+{
+    AstarContext<Arity> context;
+    return astar(g, start_idx, goal_idx, heuristic, path, &context);
+}
+
 }  // namespace simple_graph
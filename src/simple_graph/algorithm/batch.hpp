@@ -0,0 +1,153 @@
+#pragma once
+
+#include <algorithm>
+#include <limits>
+#include <utility>
+#include <vector>
+#include "simple_graph/graph.hpp"
+#include "simple_graph/graph_traits.hpp"
+#include "simple_graph/thread_pool.hpp"
+#include "simple_graph/algorithm/astar.hpp"
+#include "simple_graph/algorithm/bellman_ford.hpp"
+#include "simple_graph/algorithm/dijkstra.hpp"
+
+namespace simple_graph {
+
+/**
+ * Result of a single path query.
+ *
+ * @tparam W Typename for edge weight.
+ */
+template<typename W>
+struct PathResult {
+    /// True if path was found.
+    bool found = false;
+    /// Sum of edge weights along the path, max value of W if path wasn't found.
+    W distance = std::numeric_limits<W>::max();
+    /// Vertices of the path from start to goal, empty if path wasn't found.
+    std::vector<vertex_index_t> path;
+};
+
+namespace detail {
+
+/**
+ * Get sum of edge weights along the path, the lightest edge is taken between consecutive vertices.
+ */
+template<typename G>
+graph_weight_t<G> path_weight(const G &g, const std::vector<vertex_index_t> &path)
+{
+    using W = graph_weight_t<G>;
+    W total = 0;
+    for (size_t i = 1; i < path.size(); ++i) {
+        W weight = std::numeric_limits<W>::max();
+        for (const auto &n : g.out_neighbours(path[i - 1], 0)) {
+            if (n.idx == path[i]) {
+                weight = std::min(weight, n.weight);
+            }
+        }
+        total += weight;
+    }
+    return total;
+}
+
+}  // namespace detail
+
+/**
+ * Runner of independent path queries against one graph on a thread pool.
+ *
+ * Every worker owns its search contexts, they are kept between queries and batches, so a query allocates
+ * nothing but its result once the contexts have grown to the graph size. Results are returned in order of
+ * queries. The graph must not be modified while a batch runs, batches of one runner must not run concurrently.
+ *
+ *     BatchSearch<decltype(g)> batch(g);
+ *     auto results = batch.astar({{0, 10}, {3, 7}}, heuristic);
+ *
+ * @tparam G Typename of the graph.
+ */
+template<typename G>
+class BatchSearch {
+public:
+    using weight_type = graph_weight_t<G>;
+    using Query = std::pair<vertex_index_t, vertex_index_t>;
+
+    /**
+     * Constructor.
+     *
+     * @param g Graph to search in, must outlive the runner.
+     * @param pool Pool to run queries on, must outlive the runner.
+     */
+    explicit BatchSearch(const G &g, ThreadPool *pool = &ThreadPool::shared())
+        : g_(&g), pool_(pool), astar_contexts_(pool->size()), dijkstra_contexts_(pool->size()) {}
+
+    size_t threads() const { return pool_->size(); }
+
+    /**
+     * Find paths between pairs of vertices with A* algorithm.
+     *
+     * @param queries Pairs of start and goal vertex indices.
+     * @param heuristic Callable estimating distance between two vertices, called concurrently.
+     * @return Results in order of queries.
+     */
+    template<typename H>
+    std::vector<PathResult<weight_type>> astar(const std::vector<Query> &queries, const H &heuristic)
+    {
+        return run(queries, [this, &heuristic](size_t worker, const Query &q, std::vector<vertex_index_t> *path) {
+            return simple_graph::astar(*g_, q.first, q.second, heuristic, path, &astar_contexts_[worker]);
+        });
+    }
+
+    /**
+     * Find shortest paths between pairs of vertices with Dijkstra algorithm, weights must be non-negative.
+     *
+     * @param queries Pairs of start and goal vertex indices.
+     * @return Results in order of queries.
+     */
+    std::vector<PathResult<weight_type>> dijkstra(const std::vector<Query> &queries)
+    {
+        return run(queries, [this](size_t worker, const Query &q, std::vector<vertex_index_t> *path) {
+            auto is_goal = by_index([goal = q.second](vertex_index_t idx) { return idx == goal; });
+            return simple_graph::dijkstra(*g_, q.first, is_goal, path, &dijkstra_contexts_[worker]);
+        });
+    }
+
+    /**
+     * Find shortest paths between pairs of vertices with Bellman-Ford algorithm.
+     *
+     * @param queries Pairs of start and goal vertex indices.
+     * @return Results in order of queries.
+     * @note Bellman-Ford algorithm has no reusable state, its arrays are allocated by every query.
+     */
+    std::vector<PathResult<weight_type>> bellman_ford(const std::vector<Query> &queries)
+    {
+        return run(queries, [this](size_t, const Query &q, std::vector<vertex_index_t> *path) {
+            return simple_graph::bellman_ford(*g_, q.first, q.second, path);
+        });
+    }
+
+private:
+    template<typename Search>
+    std::vector<PathResult<weight_type>> run(const std::vector<Query> &queries, const Search &search)
+    {
+        std::vector<PathResult<weight_type>> results(queries.size());
+        /// Queries are heavy and of uneven cost, so every one of them may be stolen.
+        pool_->parallel_for(0, queries.size(), [this, &queries, &search, &results](size_t worker, size_t idx) {
+            PathResult<weight_type> &result = results[idx];
+            result.found = search(worker, queries[idx], &result.path);
+            if (result.found) {
+                result.distance = detail::path_weight(*g_, result.path);
+            }
+            else {
+                result.path.clear();
+            }
+        }, 1);
+        return results;
+    }
+
+private:
+    const G *g_;
+    ThreadPool *pool_;
+    std::vector<AstarContext<>> astar_contexts_;
+    std::vector<DijkstraContext<weight_type>> dijkstra_contexts_;
+};
+
+}  // namespace simple_graph
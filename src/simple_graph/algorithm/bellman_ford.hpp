@@ -2,9 +2,10 @@
 
 #include <algorithm>
 #include <cassert>
-#include <set>
+#include <limits>
 #include <vector>
 #include "simple_graph/graph.hpp"
+#include "simple_graph/graph_traits.hpp"
 
 namespace simple_graph {
 
@@ -14,79 +15,76 @@ bool check_distance(const W &d, const W &w)
     return !((d > 0) && (w > 0) && (std::numeric_limits<W>::max() - d < w));
 }
 
-template<bool Dir, typename V, typename E, typename W>
-bool bellman_ford(const Graph<Dir, V, E, W> &g, vertex_index_t start_idx, vertex_index_t goal_idx,
+template<typename G>
+enable_if_graph_t<G, bool> bellman_ford(const G &g, vertex_index_t start_idx, vertex_index_t goal_idx,
         std::vector<vertex_index_t> *path)
 {
+    using W = graph_weight_t<G>;
+
+    vertex_index_t vnum = vertex_bound(g);
+
     // TODO add utility function to check passed vertex indices
-    if ((start_idx < 0) || (goal_idx < 0)) {
+    if ((start_idx < 0) || (goal_idx < 0) || (start_idx >= vnum) || (goal_idx >= vnum)) {
         return false;
     }
 
-    std::vector<W> distance(g.vertex_num(), std::numeric_limits<W>::max());
-    std::vector<vertex_index_t> predecessor(g.vertex_num(), -1);
+    std::vector<W> distance(vnum, std::numeric_limits<W>::max());
+    std::vector<vertex_index_t> predecessor(vnum, -1);
 
     distance[start_idx] = 0;
 
-    auto fg = const_cast<Graph<Dir, V, E, W>*>(&g);
-
-    std::vector<Edge<E, W>> asc_edges;
-    std::vector<Edge<E, W>> desc_edges;
-    for (const auto &edge : fg->edges()) {
-        if (Dir) {
-            if (edge.idx1() < edge.idx2()) {
-                asc_edges.push_back(edge);
-            }
-            else {
-                desc_edges.push_back(edge);
+    /// Arcs are split by direction and ordered by their source so that relaxation passes follow the vertex order,
+    /// undirected edges are seen from both ends. Self-loops go to descending arcs, a negative one is a negative cycle.
+    struct Arc {
+        vertex_index_t from;
+        vertex_index_t to;
+        W weight;
+    };
+    std::vector<Arc> asc_arcs;
+    std::vector<Arc> desc_arcs;
+    for (vertex_index_t idx = 0; idx < vnum; ++idx) {
+        for (const auto &n : g.out_neighbours(idx, 0)) {
+            if (idx < n.idx) {
+                asc_arcs.push_back({idx, n.idx, n.weight});
             }
         }
-        else {
-            asc_edges.push_back(edge);
-            desc_edges.push_back(edge);
+    }
+    for (vertex_index_t idx = vnum - 1; idx >= 0; --idx) {
+        for (const auto &n : g.out_neighbours(idx, 0)) {
+            if (idx >= n.idx) {
+                desc_arcs.push_back({idx, n.idx, n.weight});
+            }
         }
     }
-    std::sort(asc_edges.begin(), asc_edges.end(), [](const Edge<E, W> &a, const Edge<E, W> &b) {
-        vertex_index_t a_idx = std::min(a.idx1(), a.idx2());
-        vertex_index_t b_idx = std::min(b.idx1(), b.idx2());
-        return a_idx < b_idx;
-    });
-    std::sort(desc_edges.begin(), desc_edges.end(), [](const Edge<E, W> &a, const Edge<E, W> &b) {
-        vertex_index_t a_idx = std::max(a.idx1(), a.idx2());
-        vertex_index_t b_idx = std::max(b.idx1(), b.idx2());
-        return b_idx < a_idx;
-    });
-
-    for (size_t i = 0; i < g.vertex_num(); ++i) {
+
+    auto can_relax = [&](const Arc &arc) {
+        return check_distance(distance[arc.from], arc.weight) && (distance[arc.from] + arc.weight < distance[arc.to]);
+    };
+    auto relax = [&](const Arc &arc) {
+        if (!can_relax(arc)) {
+            return false;
+        }
+        distance[arc.to] = distance[arc.from] + arc.weight;
+        predecessor[arc.to] = arc.from;
+        return true;
+    };
+
+    for (vertex_index_t i = 0; i < vnum; ++i) {
         bool changed = false;
-        for (const auto &edge : asc_edges) {
-            std::pair<vertex_index_t, vertex_index_t> e = std::minmax(edge.idx1(), edge.idx2());
-            if (check_distance(distance[e.first], edge.weight())
-                    && (distance[e.first] + edge.weight() < distance[e.second])) {
-                distance[e.second] = distance[e.first] + edge.weight();
-                predecessor[e.second] = e.first;
-                changed = true;
-            }
+        for (const auto &arc : asc_arcs) {
+            changed |= relax(arc);
         }
-        for (const auto &edge : desc_edges) {
-            std::pair<vertex_index_t, vertex_index_t> e = std::minmax(edge.idx1(), edge.idx2());
-            if (check_distance(distance[e.second], edge.weight())
-                    && (distance[e.second] + edge.weight() < distance[e.first])) {
-                distance[e.first] = distance[e.second] + edge.weight();
-                predecessor[e.first] = e.second;
-                changed = true;
-            }
+        for (const auto &arc : desc_arcs) {
+            changed |= relax(arc);
         }
         if (!changed) {
             break;
         }
     }
 
-    for (const auto &edge : fg->edges()) {
-        if (check_distance(distance[edge.idx1()], edge.weight())
-                && (distance[edge.idx1()] + edge.weight() < distance[edge.idx2()])) {
-            return false;
-        }
+    if (std::any_of(asc_arcs.begin(), asc_arcs.end(), can_relax)
+            || std::any_of(desc_arcs.begin(), desc_arcs.end(), can_relax)) {
+        return false;
     }
 
     if (distance[goal_idx] == std::numeric_limits<W>::max()) {
@@ -1,53 +1,60 @@
 #pragma once
 
-#include <functional>
-#include <queue>
-#include <set>
+#include <algorithm>
+#include <cstdint>
+#include <vector>
 #include "simple_graph/graph.hpp"
+#include "simple_graph/graph_traits.hpp"
+#include "simple_graph/search_context.hpp"
+#include "simple_graph/algorithm/predicate.hpp"
 
 namespace simple_graph {
 
 template<bool Dir, typename V, typename E, typename W>
-bool bfs(const Graph<Dir, V, E, W> &g, vertex_index_t start_idx, std::function<bool(V)> &pred,
-        std::vector<vertex_index_t> *path)
+class MatrixGraph;
+
+/**
+ * Find path to the nearest vertex satisfying predicate with breadth-first search reusing search state.
+ *
+ * @param g Graph to search in.
+ * @param start_idx Start vertex index.
+ * @param pred Predicate taking vertex data or wrapped with by_index(), checked for discovered vertices.
+ * @param path Found path from start to the vertex satisfying predicate.
+ * @param context Search state, reset at the start of the search.
+ * @return True if path was found, false otherwise.
+ */
+template<typename G, typename Pred>
+enable_if_graph_t<G, bool> bfs(const G &g, vertex_index_t start_idx, const Pred &pred,
+        std::vector<vertex_index_t> *path, TraversalContext *context)
 {
-    vertex_index_t vnum = g.vertex_num();
-    if (start_idx > vnum) {
+    vertex_index_t vnum = vertex_bound(g);
+    if ((start_idx < 0) || (start_idx >= vnum)) {
         return false;
     }
 
-    std::vector<bool> visited(vnum, false);
-    std::vector<vertex_index_t> prev(vnum, 0);
-    std::vector<size_t> dist(vnum, vnum + 1);
-    std::queue<vertex_index_t> queue;
+    context->reset(vnum);
+
+    /// Vertices are marked as visited once discovered, so every vertex is queued at most once.
+    auto &queue = context->queue();
+    size_t head = 0;
 
     bool vertex_found = false;
 
-    queue.push(start_idx);
-    dist[start_idx] = 0;
+    queue.push_back(start_idx);
+    context->visit(start_idx);
     vertex_index_t end_idx = 0;
 
-    while (!vertex_found && !queue.empty()) {
-        vertex_index_t u = queue.front();
-        queue.pop();
-        if (visited[u]) {
-            continue;
-        }
-
-        visited[u] = true;
+    while (!vertex_found && (head < queue.size())) {
+        vertex_index_t u = queue[head++];
 
-        const std::set<vertex_index_t> &vertices = g.outbounds(u, 1);
+        for (const auto &n : g.out_neighbours(u, 1)) {
+            vertex_index_t v = n.idx;
+            if (!context->visited(v)) {
+                context->visit(v);
+                context->set_predecessor(v, u);
 
-        for (auto v : vertices) {
-            if (!visited[v]) {
-                size_t alt = dist[u] + 1;
-                if (alt < dist[v]) {
-                    dist[v] = alt;
-                    prev[v] = u;
-                }
-
-                queue.push(v);
-                if (pred(g.vertex(v).data())) {
+                queue.push_back(v);
+                if (detail::matches(g, pred, v)) {
                     vertex_found = true;
                     end_idx = v;
                     break;
@@ -57,16 +64,125 @@ bool bfs(const Graph<Dir, V, E, W> &g, vertex_index_t start_idx, std::function<b
     }
 
     if (vertex_found) {
-        vertex_index_t v = end_idx;
-        do {
+        for (vertex_index_t v = end_idx; v != -1; v = context->predecessor(v)) {
             path->push_back(v);
-            v = prev[v];
-        } while (v != start_idx);
-        path->push_back(v);
+        }
         std::reverse(path->begin(), path->end());
     }
 
     return vertex_found;
 }
 
+/**
+ * Find path to the nearest vertex satisfying predicate with breadth-first search over bit rows of matrix.
+ *
+ * Frontier is a bitmap, next frontier is union of matrix rows of frontier vertices without visited
+ * vertices, so a level is expanded with word-wide ORs instead of per-edge checks. Vertices of a level are
+ * checked in ascending order of their indices. Path is restored from frontiers of levels: predecessor of
+ * a vertex is any vertex of the previous frontier in its inbound row.
+ *
+ * @param g Graph to search in.
+ * @param start_idx Start vertex index.
+ * @param pred Predicate taking vertex data or wrapped with by_index(), checked for discovered vertices.
+ * @param path Found path from start to the vertex satisfying predicate.
+ * @param context Search state, reset at the start of the search, keeps frontiers of levels.
+ * @return True if path was found, false otherwise.
+ */
+template<bool Dir, typename V, typename E, typename W, typename Pred>
+bool bfs(const MatrixGraph<Dir, V, E, W> &g, vertex_index_t start_idx, const Pred &pred,
+        std::vector<vertex_index_t> *path, BitTraversalContext *context)
+{
+    vertex_index_t vnum = vertex_bound(g);
+    if ((start_idx < 0) || (start_idx >= vnum)) {
+        return false;
+    }
+
+    size_t words = g.row_words();
+    context->reset(words);
+    std::uint64_t *visited = context->visited();
+    visited[start_idx / 64] |= std::uint64_t(1) << (start_idx % 64);
+    std::copy(visited, visited + words, context->add_level());
+
+    vertex_index_t end_idx = -1;
+    while (end_idx == -1) {
+        std::uint64_t *next = context->add_level();
+        size_t level = context->level_num() - 1;
+        g.expand(context->level(level - 1), next);
+        detail::row_andnot(next, next, visited, words);
+
+        bool discovered = false;
+        for (size_t i = 0; (i < words) && (end_idx == -1); ++i) {
+            for (std::uint64_t w = next[i]; w != 0; w &= w - 1) {
+                vertex_index_t v = static_cast<vertex_index_t>(i * 64 + detail::count_trailing_zeros(w));
+                discovered = true;
+                if (detail::matches(g, pred, v)) {
+                    end_idx = v;
+                    break;
+                }
+            }
+        }
+        if (!discovered) {
+            break;
+        }
+
+        detail::row_or(visited, next, words);
+    }
+
+    if (end_idx == -1) {
+        return false;
+    }
+
+    /// Walk back by levels, the lowest vertex of the previous frontier with an edge to the current one is taken.
+    path->push_back(end_idx);
+    vertex_index_t v = end_idx;
+    for (size_t level = context->level_num() - 1; level > 0; --level) {
+        const std::uint64_t *in = g.in_row(v);
+        const std::uint64_t *frontier = context->level(level - 1);
+        for (size_t i = 0; i < words; ++i) {
+            if (std::uint64_t w = in[i] & frontier[i]) {
+                v = static_cast<vertex_index_t>(i * 64 + detail::count_trailing_zeros(w));
+                break;
+            }
+        }
+        path->push_back(v);
+    }
+    std::reverse(path->begin(), path->end());
+
+    return true;
+}
+
+/**
+ * Find path to the nearest vertex satisfying predicate with breadth-first search over bit rows of matrix.
+ *
+ * @param g Graph to search in.
+ * @param start_idx Start vertex index.
+ * @param pred Predicate taking vertex data or wrapped with by_index(), checked for discovered vertices.
+ * @param path Found path from start to the vertex satisfying predicate.
+ * @return True if path was found, false otherwise.
+ */
+template<bool Dir, typename V, typename E, typename W, typename Pred>
+bool bfs(const MatrixGraph<Dir, V, E, W> &g, vertex_index_t start_idx, const Pred &pred,
+        std::vector<vertex_index_t> *path)
+{
+    BitTraversalContext context;
+    return bfs(g, start_idx, pred, path, &context);
+}
+
+/**
+ * Find path to the nearest vertex satisfying predicate with breadth-first search.
+ *
+ * @param g Graph to search in.
+ * @param start_idx Start vertex index.
+ * @param pred Predicate taking vertex data or wrapped with by_index(), checked for discovered vertices.
+ * @param path Found path from start to the vertex satisfying predicate.
+ * @return True if path was found, false otherwise.
+ */
+template<typename G, typename Pred>
+enable_if_graph_t<G, bool> bfs(const G &g, vertex_index_t start_idx, const Pred &pred,
+        std::vector<vertex_index_t> *path)
+{
+    TraversalContext context;
+    return bfs(g, start_idx, pred, path, &context);
+}
+
 }  // namespace simple_graph
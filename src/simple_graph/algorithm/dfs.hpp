@@ -1,53 +1,62 @@
 #pragma once
 
-#include <functional>
-#include <stack>
-#include <set>
+#include <algorithm>
+#include <vector>
 #include "simple_graph/graph.hpp"
+#include "simple_graph/graph_traits.hpp"
+#include "simple_graph/search_context.hpp"
+#include "simple_graph/algorithm/predicate.hpp"
 
 namespace simple_graph {
 
-template<bool Dir, typename V, typename E, typename W>
-bool dfs(const Graph<Dir, V, E, W> &g, vertex_index_t start_idx, std::function<bool(V)> &pred,
-        std::vector<vertex_index_t> *path)
+/**
+ * Find path to a vertex satisfying predicate with depth-first search reusing search state.
+ *
+ * @param g Graph to search in.
+ * @param start_idx Start vertex index.
+ * @param pred Predicate taking vertex data or wrapped with by_index(), checked for discovered vertices.
+ * @param path Found path from start to the vertex satisfying predicate.
+ * @param context Search state, reset at the start of the search.
+ * @return True if path was found, false otherwise.
+ */
+template<typename G, typename Pred>
+enable_if_graph_t<G, bool> dfs(const G &g, vertex_index_t start_idx, const Pred &pred,
+        std::vector<vertex_index_t> *path, TraversalContext *context)
 {
-    vertex_index_t vnum = g.vertex_num();
-    if (start_idx > vnum) {
+    vertex_index_t vnum = vertex_bound(g);
+    if ((start_idx < 0) || (start_idx >= vnum)) {
         return false;
     }
 
-    std::vector<bool> visited(vnum, false);
-    std::vector<vertex_index_t> prev(vnum, 0);
-    std::vector<size_t> dist(vnum, vnum + 1);
-    std::stack<vertex_index_t> stack;
+    context->reset(vnum);
+    auto &stack = context->queue();
 
     bool vertex_found = false;
 
-    stack.push(start_idx);
-    dist[start_idx] = 0;
+    stack.push_back(start_idx);
+    context->set_distance(start_idx, 0);
     vertex_index_t end_idx = 0;
 
     while (!vertex_found && !stack.empty()) {
-        vertex_index_t u = stack.top();
-        stack.pop();
-        if (visited[u]) {
+        vertex_index_t u = stack.back();
+        stack.pop_back();
+        if (context->visited(u)) {
             continue;
         }
 
-        visited[u] = true;
-
-        const std::set<vertex_index_t> &vertices = g.outbounds(u, 1);
+        context->visit(u);
 
-        for (auto v : vertices) {
-            if (!visited[v]) {
-                size_t alt = dist[u] + 1;
-                if (alt < dist[v]) {
-                    dist[v] = alt;
-                    prev[v] = u;
+        for (const auto &n : g.out_neighbours(u, 1)) {
+            vertex_index_t v = n.idx;
+            if (!context->visited(v)) {
+                size_t alt = context->distance(u) + 1;
+                if (alt < context->distance(v)) {
+                    context->set_distance(v, alt);
+                    context->set_predecessor(v, u);
                 }
 
-                stack.push(v);
-                if (pred(g.vertex(v).data())) {
+                stack.push_back(v);
+                if (detail::matches(g, pred, v)) {
                     vertex_found = true;
                     end_idx = v;
                     break;
@@ -57,16 +66,30 @@ bool dfs(const Graph<Dir, V, E, W> &g, vertex_index_t start_idx, std::function<b
     }
 
     if (vertex_found) {
-        vertex_index_t v = end_idx;
-        do {
+        for (vertex_index_t v = end_idx; v != -1; v = context->predecessor(v)) {
             path->push_back(v);
-            v = prev[v];
-        } while (v != start_idx);
-        path->push_back(v);
+        }
         std::reverse(path->begin(), path->end());
     }
 
     return vertex_found;
 }
 
+/**
+ * Find path to a vertex satisfying predicate with depth-first search.
+ *
+ * @param g Graph to search in.
+ * @param start_idx Start vertex index.
+ * @param pred Predicate taking vertex data or wrapped with by_index(), checked for discovered vertices.
+ * @param path Found path from start to the vertex satisfying predicate.
+ * @return True if path was found, false otherwise.
+ */
+template<typename G, typename Pred>
+enable_if_graph_t<G, bool> dfs(const G &g, vertex_index_t start_idx, const Pred &pred,
+        std::vector<vertex_index_t> *path)
+{
+    TraversalContext context;
+    return dfs(g, start_idx, pred, path, &context);
+}
+
 }  // namespace simple_graph
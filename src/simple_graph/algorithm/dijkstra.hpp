@@ -1,72 +1,205 @@
 #pragma once
 
-#include <functional>
-#include <queue>
-#include <set>
+#include <algorithm>
+#include <type_traits>
+#include <vector>
 #include "simple_graph/graph.hpp"
+#include "simple_graph/graph_traits.hpp"
+#include "simple_graph/indexed_heap.hpp"
+#include "simple_graph/radix_heap.hpp"
+#include "simple_graph/search_context.hpp"
+#include "simple_graph/algorithm/predicate.hpp"
 
 namespace simple_graph {
 
-template<bool Dir, typename V, typename E, typename W>
-bool dijkstra(const Graph<Dir, V, E, W> &g, vertex_index_t start_idx, std::function<bool(V)> &pred,
-        std::vector<vertex_index_t> *path)
-{
-    size_t vnum = g.vertex_num();
-    if (start_idx > vnum) {
-        return false;
-    }
+/**
+ * Frontier used by Dijkstra algorithm: radix heap for integer weights, indexed d-ary heap otherwise.
+ *
+ * @tparam W Typename for edge weight.
+ * @tparam Arity Arity of the heap for non-integer weights.
+ */
+template<typename W, size_t Arity>
+using dijkstra_queue_t = typename std::conditional<std::is_integral<W>::value,
+        RadixHeap<W>, IndexedHeap<W, Arity>>::type;
 
-    std::vector<bool> visited(vnum, false);
-    std::vector<vertex_index_t> prev(vnum, 0);
-    std::vector<size_t> dist(vnum, vnum + 1);
-    std::queue<vertex_index_t> queue;
+/**
+ * Context of Dijkstra algorithm, visited flag marks settled vertices.
+ *
+ * @tparam W Typename for edge weight.
+ * @tparam Arity Arity of the heap for non-integer weights.
+ */
+template<typename W, size_t Arity = 4>
+using DijkstraContext = SearchContext<W, dijkstra_queue_t<W, Arity>>;
 
-    bool vertex_found = false;
+namespace detail {
 
-    queue.push(start_idx);
-    dist[start_idx] = 0;
-    vertex_index_t end_idx = 0;
+/**
+ * Dijkstra algorithm kernel.
+ *
+ * Vertices are settled in order of their distance from the start vertex, search stops as soon as settled
+ * vertex satisfies the target predicate. Queue may keep outdated entries of already settled vertices,
+ * they are skipped.
+ *
+ * @param g Graph to search in.
+ * @param start_idx Start vertex index, must be valid.
+ * @param is_target Predicate taking vertex index.
+ * @param context Search state, reset at the start of the search.
+ * @return Index of the found target vertex or -1 if there is no reachable target.
+ */
+template<size_t Arity, typename G, typename Pred>
+vertex_index_t dijkstra(const G &g, vertex_index_t start_idx, const Pred &is_target,
+        DijkstraContext<graph_weight_t<G>, Arity> *context)
+{
+    using W = graph_weight_t<G>;
+    vertex_index_t vnum = vertex_bound(g);
 
-    while (!vertex_found && !queue.empty()) {
-        vertex_index_t u = queue.front();
-        queue.pop();
-        if (visited[u]) {
-            continue;
-        }
+    context->reset(vnum);
+    auto &frontier = context->queue();
+    frontier.reserve(vnum);
 
-        visited[u] = true;
+    context->set_distance(start_idx, 0);
+    frontier.push(start_idx, 0);
 
-        const std::set<vertex_index_t> &vertices = g.outbounds(u, 1);
+    while (!frontier.empty()) {
+        vertex_index_t u = frontier.pop();
+        if (context->visited(u)) {
+            continue;
+        }
+        context->visit(u);
+        if (is_target(u)) {
+            return u;
+        }
 
-        for (auto v : vertices) {
-            if (!visited[v]) {
-                size_t alt = dist[u] + 1;
-                if (alt < dist[v]) {
-                    dist[v] = alt;
-                    prev[v] = u;
-                }
+        W current = context->distance(u);
+        for (const auto &n : g.out_neighbours(u, 0)) {
+            vertex_index_t v = n.idx;
+            if (context->visited(v)) {
+                continue;
+            }
 
-                queue.push(v);
-                if (pred(g.vertex(v).data())) {
-                    vertex_found = true;
-                    end_idx = v;
-                    break;
-                }
+            W alt = current + n.weight;
+            if (alt >= context->distance(v)) {
+                continue;
             }
+
+            context->set_distance(v, alt);
+            context->set_predecessor(v, u);
+            frontier.update(v, alt);
         }
     }
 
-    if (vertex_found) {
-        vertex_index_t v = end_idx;
-        do {
-            path->push_back(v);
-            v = prev[v];
-        } while (v != start_idx);
+    return -1;
+}
+
+}  // namespace detail
+
+/**
+ * Find shortest path to the nearest vertex satisfying predicate with Dijkstra algorithm reusing search state.
+ *
+ * @tparam Arity Arity of the heap used for the frontier, ignored for integer weights.
+ * @param g Graph to search in, edge weights must be non-negative.
+ * @param start_idx Start vertex index.
+ * @param pred Predicate taking vertex data or wrapped with by_index(), checked for every vertex in order of
+ *        distance from the start vertex.
+ * @param path Found path from start to the nearest vertex satisfying predicate.
+ * @param context Search state, reset at the start of the search.
+ * @return True if path was found, false otherwise.
+ */
+template<size_t Arity = 4, typename G, typename Pred>
+enable_if_graph_t<G, bool> dijkstra(const G &g, vertex_index_t start_idx, const Pred &pred,
+        std::vector<vertex_index_t> *path, DijkstraContext<graph_weight_t<G>, Arity> *context)
+{
+    vertex_index_t vnum = vertex_bound(g);
+    if ((start_idx < 0) || (start_idx >= vnum)) {
+        return false;
+    }
+
+    vertex_index_t end_idx = detail::dijkstra<Arity>(g, start_idx,
+            [&](vertex_index_t idx) { return detail::matches(g, pred, idx); }, context);
+    if (end_idx == -1) {
+        return false;
+    }
+
+    for (vertex_index_t v = end_idx; v != -1; v = context->predecessor(v)) {
         path->push_back(v);
-        std::reverse(path->begin(), path->end());
+    }
+    std::reverse(path->begin(), path->end());
+
+    return true;
+}
+
+/**
+ * Find shortest path to the nearest vertex satisfying predicate with Dijkstra algorithm.
+ *
+ * @tparam Arity Arity of the heap used for the frontier, ignored for integer weights.
+ * @param g Graph to search in, edge weights must be non-negative.
+ * @param start_idx Start vertex index.
+ * @param pred Predicate taking vertex data or wrapped with by_index(), checked for every vertex in order of
+ *        distance from the start vertex.
+ * @param path Found path from start to the nearest vertex satisfying predicate.
+ * @return True if path was found, false otherwise.
+ */
+template<size_t Arity = 4, typename G, typename Pred>
+enable_if_graph_t<G, bool> dijkstra(const G &g, vertex_index_t start_idx, const Pred &pred,
+        std::vector<vertex_index_t> *path)
+{
+    DijkstraContext<graph_weight_t<G>, Arity> context;
+    return dijkstra<Arity>(g, start_idx, pred, path, &context);
+}
+
+/**
+ * Find shortest distances from the vertex to all other vertices with Dijkstra algorithm reusing search state.
+ *
+ * Distances and predecessors are left in the context and stay valid until its next reset.
+ *
+ * @tparam Arity Arity of the heap used for the frontier, ignored for integer weights.
+ * @param g Graph to search in, edge weights must be non-negative.
+ * @param start_idx Start vertex index.
+ * @param context Search state, reset at the start of the search.
+ * @return False if start vertex index is invalid, true otherwise.
+ */
+template<size_t Arity = 4, typename G>
+enable_if_graph_t<G, bool> dijkstra(const G &g, vertex_index_t start_idx,
+        DijkstraContext<graph_weight_t<G>, Arity> *context)
+{
+    vertex_index_t vnum = vertex_bound(g);
+    if ((start_idx < 0) || (start_idx >= vnum)) {
+        return false;
+    }
+
+    detail::dijkstra<Arity>(g, start_idx, [](vertex_index_t) { return false; }, context);
+
+    return true;
+}
+
+/**
+ * Find shortest distances from the vertex to all other vertices with Dijkstra algorithm.
+ *
+ * @tparam Arity Arity of the heap used for the frontier, ignored for integer weights.
+ * @param g Graph to search in, edge weights must be non-negative.
+ * @param start_idx Start vertex index.
+ * @param distance Distances from the start vertex, max value of W for unreachable vertices.
+ * @param predecessor Predecessors on shortest paths, -1 for the start and unreachable vertices.
+ * @return False if start vertex index is invalid, true otherwise.
+ */
+template<size_t Arity = 4, typename G>
+enable_if_graph_t<G, bool> dijkstra(const G &g, vertex_index_t start_idx, std::vector<graph_weight_t<G>> *distance,
+        std::vector<vertex_index_t> *predecessor)
+{
+    DijkstraContext<graph_weight_t<G>, Arity> context;
+    if (!dijkstra<Arity>(g, start_idx, &context)) {
+        return false;
+    }
+
+    vertex_index_t vnum = vertex_bound(g);
+    distance->resize(vnum);
+    predecessor->resize(vnum);
+    for (vertex_index_t idx = 0; idx < vnum; ++idx) {
+        (*distance)[idx] = context.distance(idx);
+        (*predecessor)[idx] = context.predecessor(idx);
     }
 
-    return vertex_found;
+    return true;
 }
 
 }  // namespace simple_graph
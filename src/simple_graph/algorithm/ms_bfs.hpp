@@ -0,0 +1,238 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <vector>
+#include "simple_graph/bitmap.hpp"
+#include "simple_graph/graph.hpp"
+#include "simple_graph/graph_traits.hpp"
+
+namespace simple_graph {
+
+/**
+ * Set of BFS sources packed in words, bit i stands for the i-th source of a multi-source BFS.
+ *
+ * Operations are loops over a fixed number of words, so compilers unroll them and use vector registers
+ * for masks wider than 64 bits.
+ *
+ * @tparam Words Number of 64-bit words, mask holds 64 * Words sources.
+ */
+template<size_t Words>
+class SourceMask {
+public:
+    static constexpr size_t capacity = 64 * Words;
+
+    SourceMask() : words_() {}
+
+    bool test(size_t i) const { return (words_[i / 64] >> (i % 64)) & 1; }
+    void set(size_t i) { words_[i / 64] |= std::uint64_t(1) << (i % 64); }
+
+    bool any() const
+    {
+        std::uint64_t res = 0;
+        for (size_t i = 0; i < Words; ++i) {
+            res |= words_[i];
+        }
+        return res != 0;
+    }
+
+    size_t count() const
+    {
+        size_t res = 0;
+        for (size_t i = 0; i < Words; ++i) {
+            res += detail::popcount(words_[i]);
+        }
+        return res;
+    }
+
+    SourceMask &operator|=(const SourceMask &mask)
+    {
+        for (size_t i = 0; i < Words; ++i) {
+            words_[i] |= mask.words_[i];
+        }
+        return *this;
+    }
+
+    /**
+     * Remove sources of the mask: `this &= ~mask`.
+     */
+    SourceMask &remove(const SourceMask &mask)
+    {
+        for (size_t i = 0; i < Words; ++i) {
+            words_[i] &= ~mask.words_[i];
+        }
+        return *this;
+    }
+
+    void clear() { words_.fill(0); }
+
+    /**
+     * Call f(i) for every source i in the mask in ascending order.
+     */
+    template<typename F>
+    void for_each(const F &f) const
+    {
+        for (size_t i = 0; i < Words; ++i) {
+            for (std::uint64_t w = words_[i]; w != 0; w &= w - 1) {
+                f(i * 64 + detail::count_trailing_zeros(w));
+            }
+        }
+    }
+
+private:
+    std::array<std::uint64_t, Words> words_;
+};
+
+namespace detail {
+
+/**
+ * Per-vertex source masks of multi-source BFS, kept between batches of sources.
+ */
+template<size_t Words>
+struct MsBfsState {
+    /// Sources which reached the vertex.
+    std::vector<SourceMask<Words>> seen;
+    /// Sources which reached the vertex at the current level.
+    std::vector<SourceMask<Words>> visit;
+    /// Sources reaching the vertex at the next level.
+    std::vector<SourceMask<Words>> next;
+
+    void reset(size_t n)
+    {
+        seen.assign(n, SourceMask<Words>());
+        visit.assign(n, SourceMask<Words>());
+        next.assign(n, SourceMask<Words>());
+    }
+};
+
+template<size_t Words, typename G, typename Visitor>
+bool ms_bfs(const G &g, const std::vector<vertex_index_t> &sources, const Visitor &visitor,
+        MsBfsState<Words> *state)
+{
+    vertex_index_t vnum = vertex_bound(g);
+    if (sources.size() > SourceMask<Words>::capacity) {
+        return false;
+    }
+    for (vertex_index_t s : sources) {
+        if ((s < 0) || (s >= vnum)) {
+            return false;
+        }
+    }
+
+    const size_t n = static_cast<size_t>(vnum);
+    state->reset(n);
+    auto &seen = state->seen;
+    auto &visit = state->visit;
+    auto &next = state->next;
+
+    for (size_t i = 0; i < sources.size(); ++i) {
+        seen[sources[i]].set(i);
+        visit[sources[i]].set(i);
+    }
+    for (size_t v = 0; v < n; ++v) {
+        if (visit[v].any()) {
+            visitor(static_cast<vertex_index_t>(v), size_t(0), visit[v]);
+        }
+    }
+
+    for (size_t level = 1; ; ++level) {
+        /// Adjacency of a vertex is scanned once per level for all sources which reached it at this level.
+        for (size_t v = 0; v < n; ++v) {
+            if (!visit[v].any()) {
+                continue;
+            }
+            for (const auto &nb : g.out_neighbours(static_cast<vertex_index_t>(v), 1)) {
+                next[nb.idx] |= visit[v];
+            }
+            visit[v].clear();
+        }
+
+        bool discovered = false;
+        for (size_t v = 0; v < n; ++v) {
+            if (!next[v].any()) {
+                continue;
+            }
+            next[v].remove(seen[v]);
+            if (next[v].any()) {
+                discovered = true;
+                seen[v] |= next[v];
+                visitor(static_cast<vertex_index_t>(v), level, next[v]);
+            }
+        }
+        if (!discovered) {
+            break;
+        }
+        visit.swap(next);
+    }
+
+    return true;
+}
+
+}  // namespace detail
+
+/**
+ * Run breadth-first searches from up to 64 * Words sources at once with multi-source bit-parallel BFS.
+ *
+ * Every vertex keeps masks of sources which have reached it, and which reached it at the current level.
+ * Adjacency list of a vertex is scanned once per level for all sources together, its mask is ORed into
+ * neighbours' masks, so searches from sources of one area share most of their edge scans. Edges are taken
+ * the same way as by bfs().
+ *
+ *     ms_bfs<4>(g, sources, [](vertex_index_t v, size_t level, const SourceMask<4> &mask) {
+ *         mask.for_each([&](size_t i) { total[i] += level; });
+ *     });
+ *
+ * @tparam Words Number of 64-bit words in a source mask, 1 for 64 sources, 4 for 256 sources.
+ * @param g Graph to search in.
+ * @param sources Start vertex indices, may repeat.
+ * @param visitor Callable with signature void(vertex_index_t v, size_t level, const SourceMask<Words> &mask),
+ *        called once per level for every vertex first reached at the level, mask holds the sources which
+ *        reached it. Sources themselves are visited at level 0.
+ * @return True if all sources are valid and fit the mask, false otherwise.
+ */
+template<size_t Words = 1, typename G, typename Visitor>
+enable_if_graph_t<G, bool> ms_bfs(const G &g, const std::vector<vertex_index_t> &sources, const Visitor &visitor)
+{
+    detail::MsBfsState<Words> state;
+    return detail::ms_bfs<Words>(g, sources, visitor, &state);
+}
+
+/**
+ * Compute hop distances from any number of sources, sources are searched in batches of 64 * Words.
+ *
+ * @tparam Words Number of 64-bit words in a source mask.
+ * @param g Graph to search in.
+ * @param sources Start vertex indices.
+ * @param level Number of edges on the shortest path from every source to every vertex, indexed by source
+ *        position and vertex index, max value if the vertex is unreachable.
+ * @return True if all sources are valid, false otherwise, levels are not modified then.
+ */
+template<size_t Words = 1, typename G>
+enable_if_graph_t<G, bool> ms_bfs_levels(const G &g, const std::vector<vertex_index_t> &sources,
+        std::vector<std::vector<size_t>> *level)
+{
+    vertex_index_t vnum = vertex_bound(g);
+    for (vertex_index_t s : sources) {
+        if ((s < 0) || (s >= vnum)) {
+            return false;
+        }
+    }
+
+    const size_t n = static_cast<size_t>(vnum);
+    level->assign(sources.size(), std::vector<size_t>(n, std::numeric_limits<size_t>::max()));
+
+    detail::MsBfsState<Words> state;
+    std::vector<vertex_index_t> batch;
+    for (size_t first = 0; first < sources.size(); first += SourceMask<Words>::capacity) {
+        size_t last = std::min(first + SourceMask<Words>::capacity, sources.size());
+        batch.assign(sources.begin() + first, sources.begin() + last);
+        detail::ms_bfs<Words>(g, batch, [level, first](vertex_index_t v, size_t l, const SourceMask<Words> &mask) {
+            mask.for_each([level, first, v, l](size_t i) { (*level)[first + i][v] = l; });
+        }, &state);
+    }
+    return true;
+}
+
+}  // namespace simple_graph
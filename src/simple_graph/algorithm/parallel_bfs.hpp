@@ -0,0 +1,228 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "simple_graph/bitmap.hpp"
+#include "simple_graph/graph.hpp"
+#include "simple_graph/graph_traits.hpp"
+#include "simple_graph/thread_pool.hpp"
+
+namespace simple_graph {
+
+namespace detail {
+
+template<typename G, typename = void>
+struct has_in_neighbours : std::false_type {};
+
+template<typename G>
+struct has_in_neighbours<G, std::void_t<decltype(std::declval<const G&>().in_neighbours(vertex_index_t()))>>
+    : std::true_type {};
+
+/// Counter of a worker on its own cache line, so workers don't share lines while counting.
+struct alignas(64) WorkerCounter {
+    size_t value = 0;
+};
+
+/**
+ * State of direction-optimizing BFS: bitmaps of visited vertices, current and next frontier.
+ *
+ * Bitmaps are arrays of atomic words, vertices are claimed with fetch_or in top-down steps, bottom-up steps
+ * write every word of the next frontier from one task only.
+ */
+class ParallelBfsState {
+public:
+    using Word = std::uint64_t;
+    static constexpr size_t word_bits = 64;
+
+    ParallelBfsState(size_t n, ThreadPool *pool)
+        : n_(n), words_((n + word_bits - 1) / word_bits), visited_(words_), frontier_(words_), next_(words_)
+    {
+        pool->parallel_for(0, words_, [this](size_t, size_t w) {
+            visited_[w].store(0, std::memory_order_relaxed);
+            frontier_[w].store(0, std::memory_order_relaxed);
+            next_[w].store(0, std::memory_order_relaxed);
+        });
+    }
+
+    size_t words() const { return words_; }
+
+    static size_t word(vertex_index_t idx) { return static_cast<size_t>(idx) / word_bits; }
+    static Word bit(vertex_index_t idx) { return Word(1) << (static_cast<size_t>(idx) % word_bits); }
+
+    /// Mask of bits of the word standing for vertices below n.
+    Word valid(size_t w) const
+    {
+        size_t tail = n_ - w * word_bits;
+        return tail >= word_bits ? ~Word(0) : (Word(1) << tail) - 1;
+    }
+
+    std::atomic<Word> &visited(size_t w) { return visited_[w]; }
+    std::atomic<Word> &frontier(size_t w) { return frontier_[w]; }
+    std::atomic<Word> &next(size_t w) { return next_[w]; }
+
+    bool in_frontier(vertex_index_t idx) const
+    {
+        return (frontier_[word(idx)].load(std::memory_order_relaxed) & bit(idx)) != 0;
+    }
+
+    /**
+     * Mark vertex as visited.
+     *
+     * @return True if the calling thread was the first to mark the vertex.
+     */
+    bool claim(vertex_index_t idx)
+    {
+        std::atomic<Word> &w = visited_[word(idx)];
+        Word b = bit(idx);
+        /// Plain load first, most neighbours are already visited and fetch_or would bounce the line.
+        if (w.load(std::memory_order_relaxed) & b) {
+            return false;
+        }
+        return (w.fetch_or(b, std::memory_order_relaxed) & b) == 0;
+    }
+
+    /// Make the next frontier current.
+    void advance() { std::swap(frontier_, next_); }
+
+private:
+    size_t n_;
+    size_t words_;
+    std::vector<std::atomic<Word>> visited_;
+    std::vector<std::atomic<Word>> frontier_;
+    std::vector<std::atomic<Word>> next_;
+};
+
+}  // namespace detail
+
+/**
+ * Compute BFS levels and tree from the vertex with direction-optimizing level-synchronous BFS on a thread pool.
+ *
+ * Every level is expanded either top-down, frontier vertices scan their outbound edges and claim unvisited
+ * neighbours, or bottom-up, unvisited vertices scan their inbound edges until a frontier vertex is found.
+ * Bottom-up steps win once the frontier covers a large part of the unvisited vertices, as most inbound scans
+ * stop at the first edge. Direction is switched by frontier size: to bottom-up when the frontier is larger than
+ * 1/14 of unvisited vertices, back to top-down when it shrinks below 1/24 of all vertices. Graphs without
+ * in_neighbours() are always expanded top-down. Edges filtered in the graph are skipped.
+ *
+ * Frontiers and visited set are bitmaps over vertex indices, so a level costs vertex_bound() / 64 word reads
+ * besides edge scans. Levels are exact, tree is any valid BFS tree, it may differ from run to run.
+ *
+ * @param g Graph to search in, must not be modified during the search.
+ * @param start_idx Start vertex index.
+ * @param level Number of edges on the shortest path from start to every vertex, max value if unreachable.
+ * @param parent Parent of every vertex in BFS tree, -1 for start and unreachable vertices.
+ * @param pool Pool to expand levels on.
+ * @return True if start vertex is valid, false otherwise.
+ */
+template<typename G>
+enable_if_graph_t<G, bool> parallel_bfs(const G &g, vertex_index_t start_idx, std::vector<size_t> *level,
+        std::vector<vertex_index_t> *parent, ThreadPool *pool = &ThreadPool::shared())
+{
+    vertex_index_t vnum = vertex_bound(g);
+    if ((start_idx < 0) || (start_idx >= vnum)) {
+        return false;
+    }
+
+    using State = detail::ParallelBfsState;
+    constexpr bool has_in = detail::has_in_neighbours<G>::value;
+    constexpr size_t alpha = 14;
+    constexpr size_t beta = 24;
+
+    const size_t n = static_cast<size_t>(vnum);
+    level->assign(n, std::numeric_limits<size_t>::max());
+    parent->assign(n, -1);
+
+    State state(n, pool);
+    std::vector<detail::WorkerCounter> discovered(pool->size());
+
+    (*level)[start_idx] = 0;
+    state.visited(State::word(start_idx)).store(State::bit(start_idx), std::memory_order_relaxed);
+    state.frontier(State::word(start_idx)).store(State::bit(start_idx), std::memory_order_relaxed);
+
+    size_t frontier_num = 1;
+    size_t unvisited = n - 1;
+    size_t prev_num = 0;
+    bool bottom_up = false;
+
+    for (size_t depth = 1; frontier_num > 0; ++depth) {
+        if (has_in) {
+            if (!bottom_up) {
+                bottom_up = frontier_num > unvisited / alpha;
+            }
+            else if ((frontier_num < n / beta) && (frontier_num < prev_num)) {
+                /// Back to top-down only once the frontier shrinks, as in Beamer et al. 2012.
+                bottom_up = false;
+            }
+        }
+        prev_num = frontier_num;
+
+        for (auto &c : discovered) {
+            c.value = 0;
+        }
+
+        if (bottom_up) {
+            if constexpr (has_in) {
+                /// Every task owns one word of vertices, so next frontier words are stored without read-modify-write.
+                pool->parallel_for(0, state.words(), [&g, &state, &discovered, level, parent, depth](size_t worker,
+                        size_t w) {
+                    State::Word unseen = ~state.visited(w).load(std::memory_order_relaxed) & state.valid(w);
+                    State::Word found = 0;
+                    for (; unseen != 0; unseen &= unseen - 1) {
+                        vertex_index_t v = static_cast<vertex_index_t>(
+                                w * State::word_bits + detail::count_trailing_zeros(unseen));
+                        for (const auto &n : g.in_neighbours(v)) {
+                            if (state.in_frontier(n.idx)) {
+                                (*parent)[v] = n.idx;
+                                (*level)[v] = depth;
+                                found |= State::bit(v);
+                                break;
+                            }
+                        }
+                    }
+                    state.next(w).store(found, std::memory_order_relaxed);
+                    if (found != 0) {
+                        state.visited(w).fetch_or(found, std::memory_order_relaxed);
+                        discovered[worker].value += detail::popcount(found);
+                    }
+                });
+            }
+        }
+        else {
+            pool->parallel_for(0, state.words(), [&state](size_t, size_t w) {
+                state.next(w).store(0, std::memory_order_relaxed);
+            });
+            pool->parallel_for(0, state.words(), [&g, &state, &discovered, level, parent, depth](size_t worker,
+                    size_t w) {
+                for (State::Word bits = state.frontier(w).load(std::memory_order_relaxed); bits != 0;
+                        bits &= bits - 1) {
+                    vertex_index_t u = static_cast<vertex_index_t>(
+                            w * State::word_bits + detail::count_trailing_zeros(bits));
+                    for (const auto &n : g.out_neighbours(u, 0)) {
+                        vertex_index_t v = n.idx;
+                        if (state.claim(v)) {
+                            (*parent)[v] = u;
+                            (*level)[v] = depth;
+                            state.next(State::word(v)).fetch_or(State::bit(v), std::memory_order_relaxed);
+                            ++discovered[worker].value;
+                        }
+                    }
+                }
+            });
+        }
+
+        state.advance();
+        frontier_num = 0;
+        for (const auto &c : discovered) {
+            frontier_num += c.value;
+        }
+        unvisited -= frontier_num;
+    }
+
+    return true;
+}
+
+}  // namespace simple_graph
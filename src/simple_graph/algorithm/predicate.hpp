@@ -0,0 +1,52 @@
+#pragma once
+
+#include <utility>
+#include "simple_graph/graph.hpp"
+
+namespace simple_graph {
+
+/**
+ * Predicate taking vertex index instead of vertex data.
+ *
+ * @tparam F Typename for callable with signature bool(vertex_index_t).
+ */
+template<typename F>
+struct IndexPredicate {
+    F f;
+};
+
+/**
+ * Wrap callable so that search algorithms pass vertex index to it instead of vertex data.
+ *
+ * @param f Callable with signature bool(vertex_index_t).
+ * @return Wrapped predicate.
+ */
+template<typename F>
+IndexPredicate<F> by_index(F f)
+{
+    return IndexPredicate<F>{std::move(f)};
+}
+
+namespace detail {
+
+/**
+ * Check vertex with predicate taking vertex data, data is passed by const reference.
+ */
+template<typename G, typename Pred>
+bool matches(const G &g, const Pred &pred, vertex_index_t idx)
+{
+    return pred(g.vertex(idx).data());
+}
+
+/**
+ * Check vertex with predicate taking vertex index, vertex itself is not looked up.
+ */
+template<typename G, typename F>
+bool matches(const G &, const IndexPredicate<F> &pred, vertex_index_t idx)
+{
+    return pred.f(idx);
+}
+
+}  // namespace detail
+
+}  // namespace simple_graph
@@ -0,0 +1,291 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <vector>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace simple_graph {
+
+namespace detail {
+
+/**
+ * Get number of trailing zero bits.
+ *
+ * @param x Value, must not be 0.
+ * @return Index of the lowest set bit.
+ */
+inline size_t count_trailing_zeros(std::uint64_t x)
+{
+#if defined(__GNUC__)
+    return __builtin_ctzll(x);
+#else
+    size_t n = 0;
+    for (; (x & 1) == 0; x >>= 1) {
+        ++n;
+    }
+    return n;
+#endif
+}
+
+/**
+ * Get number of set bits.
+ *
+ * @param x Value.
+ * @return Number of set bits.
+ */
+inline size_t popcount(std::uint64_t x)
+{
+#if defined(__GNUC__)
+    return __builtin_popcountll(x);
+#else
+    size_t n = 0;
+    for (; x != 0; x &= x - 1) {
+        ++n;
+    }
+    return n;
+#endif
+}
+
+/**
+ * Bitwise OR of bit rows: `dst |= src`.
+ *
+ * @param dst Destination row.
+ * @param src Source row.
+ * @param words Number of 64-bit words in rows.
+ */
+inline void row_or(std::uint64_t *dst, const std::uint64_t *src, size_t words)
+{
+    size_t i = 0;
+#if defined(__AVX2__)
+    for (; i + 4 <= words; i += 4) {
+        __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(dst + i));
+        __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + i));
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i), _mm256_or_si256(a, b));
+    }
+#elif defined(__SSE2__)
+    for (; i + 2 <= words; i += 2) {
+        __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(dst + i));
+        __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), _mm_or_si128(a, b));
+    }
+#endif
+    for (; i < words; ++i) {
+        dst[i] |= src[i];
+    }
+}
+
+/**
+ * Bitwise AND of bit rows: `dst = a & b`.
+ *
+ * @param dst Destination row, may be the same as one of the sources.
+ * @param a First source row.
+ * @param b Second source row.
+ * @param words Number of 64-bit words in rows.
+ */
+inline void row_and(std::uint64_t *dst, const std::uint64_t *a, const std::uint64_t *b, size_t words)
+{
+    size_t i = 0;
+#if defined(__AVX2__)
+    for (; i + 4 <= words; i += 4) {
+        __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(a + i));
+        __m256i y = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(b + i));
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i), _mm256_and_si256(x, y));
+    }
+#elif defined(__SSE2__)
+    for (; i + 2 <= words; i += 2) {
+        __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i *>(a + i));
+        __m128i y = _mm_loadu_si128(reinterpret_cast<const __m128i *>(b + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), _mm_and_si128(x, y));
+    }
+#endif
+    for (; i < words; ++i) {
+        dst[i] = a[i] & b[i];
+    }
+}
+
+/**
+ * Bitwise difference of bit rows: `dst = a & ~b`.
+ *
+ * @param dst Destination row, may be the same as one of the sources.
+ * @param a First source row.
+ * @param b Second source row.
+ * @param words Number of 64-bit words in rows.
+ */
+inline void row_andnot(std::uint64_t *dst, const std::uint64_t *a, const std::uint64_t *b, size_t words)
+{
+    size_t i = 0;
+#if defined(__AVX2__)
+    for (; i + 4 <= words; i += 4) {
+        __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(a + i));
+        __m256i y = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(b + i));
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i), _mm256_andnot_si256(y, x));
+    }
+#elif defined(__SSE2__)
+    for (; i + 2 <= words; i += 2) {
+        __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i *>(a + i));
+        __m128i y = _mm_loadu_si128(reinterpret_cast<const __m128i *>(b + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), _mm_andnot_si128(y, x));
+    }
+#endif
+    for (; i < words; ++i) {
+        dst[i] = a[i] & ~b[i];
+    }
+}
+
+/**
+ * Get number of bits set in both rows.
+ *
+ * @param a First row.
+ * @param b Second row.
+ * @param words Number of 64-bit words in rows.
+ * @return Size of intersection.
+ */
+inline size_t row_and_count(const std::uint64_t *a, const std::uint64_t *b, size_t words)
+{
+    size_t n = 0;
+    for (size_t i = 0; i < words; ++i) {
+        n += popcount(a[i] & b[i]);
+    }
+    return n;
+}
+
+/**
+ * Get number of bits set in the row before the position.
+ *
+ * @param row Row.
+ * @param pos Bit position.
+ * @return Rank of the position among set bits.
+ */
+inline size_t row_rank(const std::uint64_t *row, size_t pos)
+{
+    size_t n = 0;
+    for (size_t i = 0; i < pos / 64; ++i) {
+        n += popcount(row[i]);
+    }
+    if (pos % 64 != 0) {
+        n += popcount(row[pos / 64] & ((std::uint64_t(1) << (pos % 64)) - 1));
+    }
+    return n;
+}
+
+}  // namespace detail
+
+/**
+ * Dense set of bits packed into 64-bit words.
+ */
+class Bitmap {
+public:
+    Bitmap() : words_(), size_(0), count_(0) {}
+
+    /**
+     * Constructor.
+     *
+     * @param resource Memory resource to allocate words from.
+     */
+    explicit Bitmap(std::pmr::memory_resource *resource) : words_(resource), size_(0), count_(0) {}
+
+    explicit Bitmap(size_t size) : words_((size + 63) / 64, 0), size_(size), count_(0) {}
+
+    size_t size() const { return size_; }
+
+    /**
+     * Get number of set bits.
+     */
+    size_t count() const { return count_; }
+
+    bool none() const { return count_ == 0; }
+
+    /**
+     * Change number of bits, new bits are cleared.
+     *
+     * @param size New number of bits.
+     */
+    void resize(size_t size)
+    {
+        for (size_t pos = size; pos < size_; ++pos) {
+            reset(pos);
+        }
+        words_.resize((size + 63) / 64, 0);
+        size_ = size;
+    }
+
+    bool test(size_t pos) const
+    {
+        return (words_[pos / 64] >> (pos % 64)) & 1;
+    }
+
+    void set(size_t pos)
+    {
+        std::uint64_t mask = std::uint64_t(1) << (pos % 64);
+        count_ += (words_[pos / 64] & mask) == 0;
+        words_[pos / 64] |= mask;
+    }
+
+    void reset(size_t pos)
+    {
+        std::uint64_t mask = std::uint64_t(1) << (pos % 64);
+        count_ -= (words_[pos / 64] & mask) != 0;
+        words_[pos / 64] &= ~mask;
+    }
+
+    void assign(size_t pos, bool value)
+    {
+        if (value) {
+            set(pos);
+        }
+        else {
+            reset(pos);
+        }
+    }
+
+    /**
+     * Clear all bits keeping the size.
+     */
+    void clear()
+    {
+        std::fill(words_.begin(), words_.end(), 0);
+        count_ = 0;
+    }
+
+    /**
+     * Find first cleared bit starting from the position, whole words of set bits are skipped at once.
+     *
+     * @param pos Position to start from.
+     * @return Position of the cleared bit or size() if there is no such bit.
+     */
+    size_t find_next_clear(size_t pos) const
+    {
+        if (pos >= size_) {
+            return size_;
+        }
+
+        size_t w = pos / 64;
+        std::uint64_t word = ~words_[w] & (~std::uint64_t(0) << (pos % 64));
+        while (word == 0) {
+            if (++w == words_.size()) {
+                return size_;
+            }
+            word = ~words_[w];
+        }
+
+        size_t res = w * 64 + detail::count_trailing_zeros(word);
+        return res < size_ ? res : size_;
+    }
+
+    const std::uint64_t *words() const { return words_.data(); }
+
+private:
+    std::pmr::vector<std::uint64_t> words_;
+    size_t size_;
+    size_t count_;
+};
+
+}  // namespace simple_graph
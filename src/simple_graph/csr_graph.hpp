@@ -0,0 +1,251 @@
+#pragma once
+
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+#include "edge_index.hpp"
+#include "graph.hpp"
+#include "list_graph.hpp"
+
+namespace simple_graph {
+
+/**
+ * Immutable graph in compressed sparse row format.
+ *
+ * Adjacency of every vertex is stored as a contiguous slice of packed arrays: neighbours of vertex `idx`
+ * are `targets[offsets[idx]]..targets[offsets[idx + 1] - 1]` with weights in the parallel weights array.
+ * The graph is built once from a ListGraph and can't be modified afterwards.
+ *
+ * @tparam Dir
+ * @tparam V
+ * @tparam E
+ * @tparam W
+ */
+template<bool Dir, typename V, typename E, typename W>
+class CsrGraph final : public Graph<Dir, V, E, W> {
+public:
+    /**
+     * Build snapshot of the graph.
+     *
+     * @param g Graph to copy vertices and edges from.
+     * @note Filtered edges of the source graph are not included into the snapshot.
+     */
+    template<bool Dense>
+    explicit CsrGraph(const ListGraph<Dir, V, E, W, Dense> &g) : vertex_num_(0)
+    {
+        vertex_index_t bound = g.vertex_bound();
+
+        vertices_.resize(bound);
+        for (const auto &v : g.vertices_) {
+            vertices_[v.first] = v.second;
+        }
+        vertex_num_ = g.vertices_.size();
+
+        /// Assign each visible edge a position in the edges array.
+        EdgeIndex edge_ids;
+        edge_ids.reserve(g.edge_num());
+        edges_.reserve(g.edge_num());
+        for (const auto &edge : g.edges()) {
+            edge_ids.assign(edge.idx1(), edge.idx2(), edges_.size());
+            edges_.push_back(edge);
+        }
+
+        auto edge_id = [&](vertex_index_t idx1, vertex_index_t idx2) {
+            if (!Dir && (idx1 > idx2)) {
+                std::swap(idx1, idx2);
+            }
+            return edge_ids.find(idx1, idx2);
+        };
+
+        out_offsets_.assign(bound + 1, 0);
+        for (vertex_index_t idx = 0; idx < bound; ++idx) {
+            for (const auto &n : g.out_neighbours(idx, 0)) {
+                out_targets_.push_back(n.idx);
+                out_weights_.push_back(n.weight);
+                out_edges_.push_back(edge_id(idx, n.idx));
+            }
+            out_offsets_[idx + 1] = out_targets_.size();
+        }
+
+        if (Dir) {
+            in_offsets_.assign(bound + 1, 0);
+            for (vertex_index_t idx = 0; idx < bound; ++idx) {
+                for (const auto &n : g.in_neighbours(idx)) {
+                    in_sources_.push_back(n.idx);
+                    in_weights_.push_back(n.weight);
+                }
+                in_offsets_[idx + 1] = in_sources_.size();
+            }
+        }
+    }
+
+    void add_vertex(Vertex<V>) override
+    {
+        throw std::logic_error("CsrGraph is immutable");
+    }
+
+    void rm_vertex(vertex_index_t) override
+    {
+        throw std::logic_error("CsrGraph is immutable");
+    }
+
+    std::set<vertex_index_t> inbounds(vertex_index_t idx) const override
+    {
+        std::set<vertex_index_t> res;
+        for (const auto &n : in_neighbours(idx)) {
+            res.insert(res.end(), n.idx);
+        }
+        return res;
+    }
+
+    std::set<vertex_index_t> outbounds(vertex_index_t idx, int mode) const override
+    {
+        std::set<vertex_index_t> res;
+        for (const auto &n : out_neighbours(idx, mode)) {
+            res.insert(res.end(), n.idx);
+        }
+        return res;
+    }
+
+    NeighbourRange<W> in_neighbours(vertex_index_t idx) const override
+    {
+        /// Undirected graph is symmetric, inbounds are the same as outbounds.
+        if (!Dir) {
+            return out_neighbours(idx, 0);
+        }
+        if ((idx < 0) || (idx >= bound())) {
+            return {};
+        }
+        return NeighbourRange<W>(in_sources_.data() + in_offsets_[idx], in_weights_.data() + in_offsets_[idx],
+                nullptr, in_offsets_[idx + 1] - in_offsets_[idx]);
+    }
+
+    NeighbourRange<W> out_neighbours(vertex_index_t idx, int) const override
+    {
+        if ((idx < 0) || (idx >= bound())) {
+            return {};
+        }
+        return NeighbourRange<W>(out_targets_.data() + out_offsets_[idx], out_weights_.data() + out_offsets_[idx],
+                nullptr, out_offsets_[idx + 1] - out_offsets_[idx]);
+    }
+
+    const Vertex<V> &vertex(vertex_index_t idx) const override
+    {
+        if ((idx < 0) || (idx >= bound()) || (vertices_[idx].idx() != idx)) {
+            throw std::out_of_range("Vertex index is not presented");
+        }
+        return vertices_[idx];
+    }
+
+    size_t vertex_num() const override { return vertex_num_; }
+
+    vertex_index_t vertex_bound() const override { return bound(); }
+
+    void add_edge(Edge<E, W>) override
+    {
+        throw std::logic_error("CsrGraph is immutable");
+    }
+
+    EdgeRef<E, W> edge(vertex_index_t idx1, vertex_index_t idx2) const override
+    {
+        size_t slot = find_slot(idx1, idx2);
+        if (slot == out_targets_.size()) {
+            throw std::out_of_range("Edge is not presented");
+        }
+        return EdgeRef<E, W>(&edges_, out_edges_[slot]);
+    }
+
+    bool edge_exists(Edge<E, W> edge) const override
+    {
+        return find_slot(edge.idx1(), edge.idx2()) != out_targets_.size();
+    }
+
+    void rm_edge(Edge<E, W>) override
+    {
+        throw std::logic_error("CsrGraph is immutable");
+    }
+
+    size_t edge_num() const override
+    {
+        return edges_.size();
+    }
+
+    bool filter_edge(Edge<E, W>) override
+    {
+        throw std::logic_error("CsrGraph is immutable");
+    }
+
+    bool filter_edges(const std::vector<Edge<E, W>> &) override
+    {
+        throw std::logic_error("CsrGraph is immutable");
+    }
+
+    bool restore_edge(Edge<E, W>) override
+    {
+        throw std::logic_error("CsrGraph is immutable");
+    }
+
+    bool restore_edges(const std::vector<Edge<E, W>> &) override
+    {
+        throw std::logic_error("CsrGraph is immutable");
+    }
+
+    void restore_edges() override {}
+
+    EdgeRange<E, W> edges() const override
+    {
+        return EdgeRange<E, W>(&edges_, nullptr);
+    }
+
+private:
+    vertex_index_t bound() const
+    {
+        return static_cast<vertex_index_t>(vertices_.size());
+    }
+
+    /**
+     * Find position of edge `idx1 -> idx2` in the packed arrays.
+     *
+     * @return Slot index or number of slots if there is no such edge.
+     */
+    size_t find_slot(vertex_index_t idx1, vertex_index_t idx2) const
+    {
+        if ((idx1 < 0) || (idx1 >= bound())) {
+            return out_targets_.size();
+        }
+
+        auto first = out_targets_.begin() + out_offsets_[idx1];
+        auto last = out_targets_.begin() + out_offsets_[idx1 + 1];
+        auto it = std::lower_bound(first, last, idx2);
+        if ((it == last) || (*it != idx2)) {
+            return out_targets_.size();
+        }
+        return static_cast<size_t>(it - out_targets_.begin());
+    }
+
+private:
+    size_t vertex_num_;
+    std::vector<Vertex<V>> vertices_;
+    std::vector<size_t> out_offsets_;
+    std::vector<vertex_index_t> out_targets_;
+    std::vector<W> out_weights_;
+    std::vector<size_t> out_edges_;
+    std::vector<size_t> in_offsets_;
+    std::vector<vertex_index_t> in_sources_;
+    std::vector<W> in_weights_;
+    EdgeStore<E, W> edges_;
+};
+
+/**
+ * Build immutable CSR snapshot of the graph.
+ *
+ * @param g Graph to freeze.
+ * @return Snapshot of the graph without filtered edges.
+ */
+template<bool Dir, typename V, typename E, typename W, bool Dense>
+CsrGraph<Dir, V, E, W> freeze(const ListGraph<Dir, V, E, W, Dense> &g)
+{
+    return CsrGraph<Dir, V, E, W>(g);
+}
+
+}  // namespace simple_graph
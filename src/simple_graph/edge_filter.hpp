@@ -0,0 +1,309 @@
+#pragma once
+
+#include <algorithm>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include "simple_graph/bitmap.hpp"
+#include "simple_graph/edge_index.hpp"
+#include "simple_graph/graph.hpp"
+#include "simple_graph/graph_traits.hpp"
+
+namespace simple_graph {
+
+/**
+ * Set of edges hidden from a query.
+ *
+ * Unlike Graph::filter_edge() the filter lives outside the graph, so queries with different filters can run
+ * over one shared graph concurrently and the graph is never modified. Edges are keyed by their endpoints in
+ * a flat hash set, bitmap of vertices having blocked edges lets traversal of other vertices skip hash lookups.
+ */
+class EdgeFilter {
+public:
+    /**
+     * Constructor.
+     *
+     * @param directed False if blocked edges are undirected, i.e. block both directions.
+     */
+    explicit EdgeFilter(bool directed) : directed_(directed), endpoints_(), edges_() {}
+
+    /**
+     * Construct filter for edges of the graph.
+     *
+     * @param g Graph, only its direction is taken.
+     */
+    template<typename G, typename = std::enable_if_t<is_graph_v<G>>>
+    explicit EdgeFilter(const G &g) : EdgeFilter(graph_traits<G>::directed)
+    {
+        endpoints_.resize(static_cast<size_t>(vertex_bound(g)));
+    }
+
+    /**
+     * Get number of blocked edges.
+     */
+    size_t size() const { return edges_.size(); }
+
+    bool empty() const { return edges_.empty(); }
+
+    /**
+     * Hide edge from queries using the filter, edge doesn't have to be in the graph.
+     *
+     * @param idx1 Source vertex index.
+     * @param idx2 Target vertex index.
+     * @throw std::out_of_range if some index is negative.
+     */
+    void block(vertex_index_t idx1, vertex_index_t idx2)
+    {
+        if ((idx1 < 0) || (idx2 < 0)) {
+            throw std::out_of_range("Vertex with invalid index");
+        }
+
+        normalize(&idx1, &idx2);
+        if (edges_.find(idx1, idx2) != EdgeIndex::npos) {
+            return;
+        }
+        edges_.insert(idx1, idx2, 0);
+
+        size_t bound = static_cast<size_t>(std::max(idx1, idx2)) + 1;
+        if (endpoints_.size() < bound) {
+            endpoints_.resize(bound);
+        }
+        endpoints_.set(static_cast<size_t>(idx1));
+        endpoints_.set(static_cast<size_t>(idx2));
+    }
+
+    /**
+     * Make edge visible again.
+     *
+     * @param idx1 Source vertex index.
+     * @param idx2 Target vertex index.
+     * @note Endpoints stay marked until clear(), so their edges are still checked against the hash set.
+     */
+    void unblock(vertex_index_t idx1, vertex_index_t idx2)
+    {
+        normalize(&idx1, &idx2);
+        edges_.erase(idx1, idx2);
+    }
+
+    /**
+     * Check if edge is blocked.
+     *
+     * @param idx1 Source vertex index.
+     * @param idx2 Target vertex index.
+     */
+    bool blocks(vertex_index_t idx1, vertex_index_t idx2) const
+    {
+        if (!touches(idx1)) {
+            return false;
+        }
+        normalize(&idx1, &idx2);
+        return edges_.find(idx1, idx2) != EdgeIndex::npos;
+    }
+
+    /**
+     * Check if some blocked edge may be incident to the vertex, cheap test done before blocks().
+     *
+     * @param idx Vertex index.
+     */
+    bool touches(vertex_index_t idx) const
+    {
+        return (idx >= 0) && (static_cast<size_t>(idx) < endpoints_.size()) && endpoints_.test(idx);
+    }
+
+    /**
+     * Unblock all edges keeping allocated memory, so the filter can be reused by the next query.
+     */
+    void clear()
+    {
+        edges_.clear();
+        endpoints_.clear();
+    }
+
+private:
+    void normalize(vertex_index_t *idx1, vertex_index_t *idx2) const
+    {
+        /// Undirected edge is stored as min_idx->max_idx, same as in ListGraph.
+        if (!directed_ && (*idx1 > *idx2)) {
+            std::swap(*idx1, *idx2);
+        }
+    }
+
+private:
+    bool directed_;
+    Bitmap endpoints_;
+    EdgeIndex edges_;
+};
+
+/**
+ * Range of neighbours skipping edges blocked by a filter.
+ *
+ * @tparam Range Typename for underlying neighbour range.
+ */
+template<typename Range>
+class FilteredNeighbourRange {
+    using BaseIterator = decltype(std::declval<const Range&>().begin());
+
+public:
+    class Iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = typename std::iterator_traits<BaseIterator>::value_type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = typename std::iterator_traits<BaseIterator>::pointer;
+        using reference = typename std::iterator_traits<BaseIterator>::reference;
+
+        /**
+         * Constructor.
+         *
+         * @param it Current position in the underlying range.
+         * @param end End of the underlying range.
+         * @param filter Edge filter, nullptr if no edge of the vertex is blocked.
+         * @param idx Vertex which neighbours are iterated.
+         * @param inbound True if neighbours are sources of edges, false if they are targets.
+         */
+        Iterator(BaseIterator it, BaseIterator end, const EdgeFilter *filter, vertex_index_t idx, bool inbound)
+            : it_(it), end_(end), filter_(filter), idx_(idx), inbound_(inbound)
+        {
+            skip_blocked();
+        }
+
+        reference operator*() const { return *it_; }
+
+        Iterator &operator++()
+        {
+            ++it_;
+            skip_blocked();
+            return *this;
+        }
+
+        Iterator operator++(int)
+        {
+            Iterator tmp = *this;
+            ++*this;
+            return tmp;
+        }
+
+        bool operator==(const Iterator &it) const { return it_ == it.it_; }
+        bool operator!=(const Iterator &it) const { return it_ != it.it_; }
+
+    private:
+        void skip_blocked()
+        {
+            if (filter_) {
+                while ((it_ != end_) && blocked((*it_).idx)) {
+                    ++it_;
+                }
+            }
+        }
+
+        bool blocked(vertex_index_t n) const
+        {
+            return inbound_ ? filter_->blocks(n, idx_) : filter_->blocks(idx_, n);
+        }
+
+    private:
+        BaseIterator it_;
+        BaseIterator end_;
+        const EdgeFilter *filter_;
+        vertex_index_t idx_;
+        bool inbound_;
+    };
+
+    /**
+     * Constructor.
+     *
+     * @param range Underlying neighbour range.
+     * @param filter Edge filter.
+     * @param idx Vertex which neighbours are iterated.
+     * @param inbound True if neighbours are sources of edges, false if they are targets.
+     */
+    FilteredNeighbourRange(const Range &range, const EdgeFilter &filter, vertex_index_t idx, bool inbound)
+        : begin_(range.begin(), range.end(), filter.touches(idx) ? &filter : nullptr, idx, inbound),
+          end_(range.end(), range.end(), nullptr, idx, inbound) {}
+
+    Iterator begin() const { return begin_; }
+    Iterator end() const { return end_; }
+    bool empty() const { return begin_ == end_; }
+
+private:
+    Iterator begin_;
+    Iterator end_;
+};
+
+/**
+ * Read-only view of a graph without edges blocked by a filter.
+ *
+ * The view satisfies is_graph, so every search algorithm takes it in place of the graph:
+ *
+ *     EdgeFilter filter(g);
+ *     filter.block(3, 4);
+ *     astar(filtered(g, filter), start, goal, heuristic, &path);
+ *
+ * Neither the graph nor the filter is copied, both must outlive the view.
+ *
+ * @tparam G Typename of the underlying graph.
+ */
+template<typename G>
+class FilteredGraph {
+public:
+    static constexpr bool directed = graph_traits<G>::directed;
+    using vertex_type = typename graph_traits<G>::vertex_type;
+    using edge_params_type = typename graph_traits<G>::edge_params_type;
+    using weight_type = typename graph_traits<G>::weight_type;
+
+    FilteredGraph(const G &g, const EdgeFilter &filter) : g_(&g), filter_(&filter) {}
+
+    const G &graph() const { return *g_; }
+    const EdgeFilter &filter() const { return *filter_; }
+
+    size_t vertex_num() const { return g_->vertex_num(); }
+    vertex_index_t vertex_bound() const { return simple_graph::vertex_bound(*g_); }
+
+    decltype(auto) vertex(vertex_index_t idx) const
+    {
+        return g_->vertex(idx);
+    }
+
+    /**
+     * Get outbound neighbours of the vertex.
+     *
+     * @param idx Vertex index.
+     * @param mode Passed to the underlying graph, edges blocked by the filter are skipped in any mode.
+     */
+    auto out_neighbours(vertex_index_t idx, int mode) const
+    {
+        using Range = decltype(g_->out_neighbours(idx, mode));
+        return FilteredNeighbourRange<Range>(g_->out_neighbours(idx, mode), *filter_, idx, false);
+    }
+
+    /**
+     * Get inbound neighbours of the vertex, edges blocked by the filter are skipped.
+     *
+     * @param idx Vertex index.
+     */
+    auto in_neighbours(vertex_index_t idx) const
+    {
+        using Range = decltype(g_->in_neighbours(idx));
+        return FilteredNeighbourRange<Range>(g_->in_neighbours(idx), *filter_, idx, true);
+    }
+
+private:
+    const G *g_;
+    const EdgeFilter *filter_;
+};
+
+/**
+ * Make view of the graph without edges blocked by the filter.
+ *
+ * @param g Graph.
+ * @param filter Edge filter.
+ * @return View to pass to search algorithms.
+ */
+template<typename G>
+FilteredGraph<G> filtered(const G &g, const EdgeFilter &filter)
+{
+    return FilteredGraph<G>(g, filter);
+}
+
+}  // namespace simple_graph
@@ -0,0 +1,322 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <vector>
+#include "bitmap.hpp"
+#include "graph.hpp"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace simple_graph {
+
+namespace detail {
+
+/**
+ * Group of control bytes of the edge index, probed at once.
+ *
+ * Control byte of a used slot holds 7 low bits of the key hash, empty and deleted slots are marked with
+ * negative values. Matching a byte against the whole group takes a couple of SSE2 instructions, scalar
+ * loop is used when SSE2 isn't available.
+ */
+class ControlGroup {
+public:
+    static constexpr size_t width = 16;
+    static constexpr std::int8_t empty = -128;
+    static constexpr std::int8_t deleted = -2;
+
+    explicit ControlGroup(const std::int8_t *ctrl) : ctrl_(ctrl) {}
+
+    /**
+     * Get mask of slots with the specified control byte.
+     *
+     * @param h2 Control byte.
+     * @return Bit mask, bit i is set if slot i of the group matches.
+     */
+    std::uint32_t match(std::int8_t h2) const
+    {
+#if defined(__SSE2__)
+        __m128i group = _mm_loadu_si128(reinterpret_cast<const __m128i *>(ctrl_));
+        return static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(group, _mm_set1_epi8(h2))));
+#else
+        std::uint32_t mask = 0;
+        for (size_t i = 0; i < width; ++i) {
+            mask |= std::uint32_t(ctrl_[i] == h2) << i;
+        }
+        return mask;
+#endif
+    }
+
+    std::uint32_t match_empty() const
+    {
+        return match(empty);
+    }
+
+    /**
+     * Get mask of slots which are free for insertion.
+     */
+    std::uint32_t match_free() const
+    {
+#if defined(__SSE2__)
+        __m128i group = _mm_loadu_si128(reinterpret_cast<const __m128i *>(ctrl_));
+        return static_cast<std::uint32_t>(_mm_movemask_epi8(group));
+#else
+        std::uint32_t mask = 0;
+        for (size_t i = 0; i < width; ++i) {
+            mask |= std::uint32_t(ctrl_[i] < 0) << i;
+        }
+        return mask;
+#endif
+    }
+
+private:
+    const std::int8_t *ctrl_;
+};
+
+}  // namespace detail
+
+/**
+ * Map from edge endpoints to edge position in the edge storage.
+ *
+ * Flat open-addressing hash table in Swiss-table style: slots are split into groups of 16, each slot has
+ * a control byte with 7 bits of the key hash. Lookup probes control bytes of a whole group at once and
+ * compares keys only for slots whose control byte matches, so the common case touches one group of
+ * control bytes and one slot.
+ */
+class EdgeIndex {
+    using Group = detail::ControlGroup;
+
+public:
+    static constexpr size_t npos = static_cast<size_t>(-1);
+
+    EdgeIndex() : ctrl_(), slots_(), size_(0), used_(0) {}
+
+    /**
+     * Constructor.
+     *
+     * @param resource Memory resource to allocate the table from.
+     */
+    explicit EdgeIndex(std::pmr::memory_resource *resource) : ctrl_(resource), slots_(resource), size_(0), used_(0) {}
+
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+
+    /**
+     * Make room for edges without rehashing.
+     *
+     * @param size Expected number of edges.
+     */
+    void reserve(size_t size)
+    {
+        if (size > max_load(slots_.size())) {
+            rehash(size);
+        }
+    }
+
+    void clear()
+    {
+        std::fill(ctrl_.begin(), ctrl_.end(), Group::empty);
+        size_ = 0;
+        used_ = 0;
+    }
+
+    /**
+     * Find edge position.
+     *
+     * @param idx1 Source vertex index.
+     * @param idx2 Target vertex index.
+     * @return Edge position or npos if there is no such edge.
+     */
+    size_t find(vertex_index_t idx1, vertex_index_t idx2) const
+    {
+        size_t slot = find_slot(idx1, idx2, hash(idx1, idx2));
+        return slot == npos ? npos : slots_[slot].value;
+    }
+
+    /**
+     * Set position of the edge, adding the edge if it's absent.
+     *
+     * @param idx1 Source vertex index.
+     * @param idx2 Target vertex index.
+     * @param value Edge position.
+     */
+    void assign(vertex_index_t idx1, vertex_index_t idx2, size_t value)
+    {
+        std::uint64_t h = hash(idx1, idx2);
+        size_t slot = find_slot(idx1, idx2, h);
+        if (slot != npos) {
+            slots_[slot].value = value;
+            return;
+        }
+
+        insert(idx1, idx2, value, h);
+    }
+
+    /**
+     * Add the edge without checking for duplicates.
+     *
+     * @param idx1 Source vertex index.
+     * @param idx2 Target vertex index.
+     * @param value Edge position.
+     * @note The edge must be absent.
+     */
+    void insert(vertex_index_t idx1, vertex_index_t idx2, size_t value)
+    {
+        insert(idx1, idx2, value, hash(idx1, idx2));
+    }
+
+    /**
+     * Remove the edge.
+     *
+     * @param idx1 Source vertex index.
+     * @param idx2 Target vertex index.
+     * @return True if edge was removed, false if there was no such edge.
+     */
+    bool erase(vertex_index_t idx1, vertex_index_t idx2)
+    {
+        size_t slot = find_slot(idx1, idx2, hash(idx1, idx2));
+        if (slot == npos) {
+            return false;
+        }
+
+        /// Probing stops at group with an empty slot, so the slot may become empty if its group has one.
+        size_t group = slot - slot % Group::width;
+        if (Group(&ctrl_[group]).match_empty() != 0) {
+            ctrl_[slot] = Group::empty;
+            --used_;
+        }
+        else {
+            ctrl_[slot] = Group::deleted;
+        }
+        --size_;
+
+        return true;
+    }
+
+private:
+    struct Slot {
+        vertex_index_t idx1;
+        vertex_index_t idx2;
+        size_t value;
+    };
+
+    static std::uint64_t hash(vertex_index_t idx1, vertex_index_t idx2)
+    {
+        std::uint64_t h = static_cast<std::uint64_t>(idx1) * 0x9E3779B97F4A7C15ull ^ static_cast<std::uint64_t>(idx2);
+        h ^= h >> 32;
+        h *= 0xD6E8FEB86659FD93ull;
+        h ^= h >> 32;
+        return h;
+    }
+
+    static std::int8_t h2(std::uint64_t h)
+    {
+        return static_cast<std::int8_t>(h & 0x7F);
+    }
+
+    /**
+     * Get maximal number of used slots, at most 7/8 of slots may be used.
+     */
+    static size_t max_load(size_t capacity)
+    {
+        return capacity - capacity / 8;
+    }
+
+    size_t group_num() const
+    {
+        return slots_.size() / Group::width;
+    }
+
+    size_t find_slot(vertex_index_t idx1, vertex_index_t idx2, std::uint64_t h) const
+    {
+        if (slots_.empty()) {
+            return npos;
+        }
+
+        size_t mask = group_num() - 1;
+        size_t group = (h >> 7) & mask;
+        for (size_t step = 1; ; ++step) {
+            Group g(&ctrl_[group * Group::width]);
+            for (std::uint32_t m = g.match(h2(h)); m != 0; m &= m - 1) {
+                size_t slot = group * Group::width + detail::count_trailing_zeros(m);
+                if ((slots_[slot].idx1 == idx1) && (slots_[slot].idx2 == idx2)) {
+                    return slot;
+                }
+            }
+            if (g.match_empty() != 0) {
+                return npos;
+            }
+            /// Triangular probing visits every group when number of groups is a power of two.
+            group = (group + step) & mask;
+        }
+    }
+
+    void insert(vertex_index_t idx1, vertex_index_t idx2, size_t value, std::uint64_t h)
+    {
+        if (used_ + 1 > max_load(slots_.size())) {
+            rehash(size_ + 1);
+        }
+
+        size_t slot = find_free(h);
+        used_ += ctrl_[slot] == Group::empty;
+        ctrl_[slot] = h2(h);
+        slots_[slot] = {idx1, idx2, value};
+        ++size_;
+    }
+
+    size_t find_free(std::uint64_t h) const
+    {
+        size_t mask = group_num() - 1;
+        size_t group = (h >> 7) & mask;
+        for (size_t step = 1; ; ++step) {
+            std::uint32_t m = Group(&ctrl_[group * Group::width]).match_free();
+            if (m != 0) {
+                return group * Group::width + detail::count_trailing_zeros(m);
+            }
+            group = (group + step) & mask;
+        }
+    }
+
+    /**
+     * Rebuild the table dropping deleted slots.
+     *
+     * @param size Number of edges the table must fit.
+     */
+    void rehash(size_t size)
+    {
+        size_t capacity = Group::width;
+        while (max_load(capacity) < size) {
+            capacity *= 2;
+        }
+
+        std::pmr::vector<std::int8_t> ctrl(capacity, Group::empty, ctrl_.get_allocator());
+        std::pmr::vector<Slot> slots(capacity, slots_.get_allocator());
+        ctrl.swap(ctrl_);
+        slots.swap(slots_);
+        used_ = 0;
+
+        for (size_t slot = 0; slot < ctrl.size(); ++slot) {
+            if (ctrl[slot] >= 0) {
+                std::uint64_t h = hash(slots[slot].idx1, slots[slot].idx2);
+                size_t free = find_free(h);
+                ctrl_[free] = h2(h);
+                slots_[free] = slots[slot];
+                ++used_;
+            }
+        }
+    }
+
+private:
+    std::pmr::vector<std::int8_t> ctrl_;
+    std::pmr::vector<Slot> slots_;
+    /// Number of edges.
+    size_t size_;
+    /// Number of non-empty slots, including deleted ones.
+    size_t used_;
+};
+
+}  // namespace simple_graph
@@ -1,16 +1,34 @@
 #pragma once
 
-#include <memory>
+#include <cstdint>
+#include <iterator>
+#include <memory_resource>
 #include <set>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 #include <gsl/gsl>
-
-// TODO use move semantics
+#include "bitmap.hpp"
+#include "instrument.hpp"
 
 namespace simple_graph {
 
+/**
+ * Typename for vertex indices.
+ *
+ * Defaults to gsl::index. Define SIMPLE_GRAPH_INDEX_TYPE as a narrower signed integer, e.g. std::int32_t, to halve
+ * the size of adjacency arrays, edge endpoints and per-vertex search state when graphs have less than 2^31 vertices.
+ * All translation units of a program must be built with the same definition.
+ */
+#if defined(SIMPLE_GRAPH_INDEX_TYPE)
+typedef SIMPLE_GRAPH_INDEX_TYPE vertex_index_t;
+#else
 typedef gsl::index vertex_index_t;
+#endif
+
+static_assert(std::is_integral<vertex_index_t>::value && std::is_signed<vertex_index_t>::value,
+        "Signed integer number required for vertex index typename.");
 
 /**
  * Graph vertex.
@@ -21,29 +39,44 @@ template<typename T>
 class Vertex {
 public:
     Vertex() : idx_(-1), data_() {
-        ++default_creations;
+        SIMPLE_GRAPH_COUNT(Vertex, default_creations);
     }
 
     explicit Vertex(vertex_index_t idx) : idx_(idx), data_()
     {
-        ++creations;
+        SIMPLE_GRAPH_COUNT(Vertex, creations);
     }
 
     Vertex(vertex_index_t idx, const T &data) : idx_(idx), data_(data)
     {
-        ++creations;
+        SIMPLE_GRAPH_COUNT(Vertex, creations);
+    }
+
+    Vertex(vertex_index_t idx, T &&data) : idx_(idx), data_(std::move(data))
+    {
+        SIMPLE_GRAPH_COUNT(Vertex, creations);
     }
 
-    Vertex(const Vertex<T> &v)
+    /**
+     * Construct vertex data in place.
+     *
+     * @param idx Vertex index.
+     * @param args Arguments of vertex data constructor.
+     */
+    template<typename... Args>
+    Vertex(vertex_index_t idx, std::in_place_t, Args &&...args) : idx_(idx), data_(std::forward<Args>(args)...)
     {
-        ++copies;
-        idx_ = v.idx_;
-        data_ = v.data_;
+        SIMPLE_GRAPH_COUNT(Vertex, creations);
+    }
+
+    Vertex(const Vertex<T> &v) : idx_(v.idx_), data_(v.data_)
+    {
+        SIMPLE_GRAPH_COUNT(Vertex, copies);
     }
 
     Vertex &operator=(const Vertex<T> &v)
-            {
-        ++assigns;
+    {
+        SIMPLE_GRAPH_COUNT(Vertex, assigns);
         if (this != &v) {
             idx_ = v.idx_;
             data_ = v.data_;
@@ -51,62 +84,46 @@ public:
         return *this;
     }
 
-    Vertex(Vertex<T> &&v)
-            noexcept(noexcept(std::is_nothrow_move_constructible<T>::value && std::is_nothrow_move_assignable<T>::value))
+    Vertex(Vertex<T> &&v) noexcept(std::is_nothrow_move_constructible<T>::value)
+        : idx_(v.idx_), data_(std::move(v.data_))
     {
-        ++moves;
-        idx_ = v.idx_;
-        std::swap(data_, v.data_);
+        SIMPLE_GRAPH_COUNT(Vertex, moves);
     }
 
-    Vertex &operator=(Vertex<T> &&v)
-            noexcept(noexcept(std::is_nothrow_move_constructible<T>::value && std::is_nothrow_move_assignable<T>::value))
+    Vertex &operator=(Vertex<T> &&v) noexcept(std::is_nothrow_move_assignable<T>::value)
     {
-        ++moves;
+        SIMPLE_GRAPH_COUNT(Vertex, moves);
         if (this != &v) {
             idx_ = v.idx_;
-            std::swap(data_, v.data_);
+            data_ = std::move(v.data_);
         }
         return *this;
     }
 
-    virtual ~Vertex() = default;
+    ~Vertex() = default;
 
     vertex_index_t idx() const { return idx_; }
-    T data() const { return data_; }
+    const T &data() const { return data_; }
 
     bool operator<(const Vertex<T> &vertex) const
     {
         return idx_ < vertex.idx_;
     }
 
-/// Counters to track down objects manipulations.
-public:
-    static int default_creations;
-    static int creations;
-    static int copies;
-    static int moves;
-    static int assigns;
+    /**
+     * Get counters of vertex manipulations made by the calling thread.
+     *
+     * @return Counters, all zeros unless SIMPLE_GRAPH_INSTRUMENT is defined.
+     */
+    static ObjectCounters counters() { return instrument::object_counters<Vertex>(); }
 
-    static std::string stat()
-    {
-        return "creations: " + std::to_string(default_creations) + " + " + std::to_string(creations)
-                + "; copies: " + std::to_string(copies)
-                + "; moves: " + std::to_string(moves)
-                + "; assigns: " + std::to_string(assigns);
-    }
+    static void reset_counters() { instrument::object_counters<Vertex>() = ObjectCounters(); }
 
 private:
     vertex_index_t idx_;
     T data_;
 };
 
-template<typename T> int Vertex<T>::default_creations = 0;
-template<typename T> int Vertex<T>::creations = 0;
-template<typename T> int Vertex<T>::copies = 0;
-template<typename T> int Vertex<T>::moves = 0;
-template<typename T> int Vertex<T>::assigns = 0;
-
 
 /**
  * Graph edge.
@@ -122,30 +139,30 @@ class Edge {
 public:
     Edge() : idx1_(-1), idx2_(-1), params_(), weight_(1)
     {
-        ++default_creations;
+        SIMPLE_GRAPH_COUNT(Edge, default_creations);
     }
 
     Edge(vertex_index_t idx1, vertex_index_t idx2, P params)
         : idx1_(idx1), idx2_(idx2), params_(std::move(params)), weight_(1)
     {
-        ++creations;
+        SIMPLE_GRAPH_COUNT(Edge, creations);
     }
 
     Edge(vertex_index_t idx1, vertex_index_t idx2, P params, W weight)
         : idx1_(idx1), idx2_(idx2), params_(std::move(params)), weight_(weight)
     {
-        ++creations;
+        SIMPLE_GRAPH_COUNT(Edge, creations);
     }
 
     Edge(const Edge<P, W> &edge)
-        : idx1_(edge.idx1_), idx2_(edge.idx2_), params_(std::move(edge.params_)), weight_(edge.weight_)
+        : idx1_(edge.idx1_), idx2_(edge.idx2_), params_(edge.params_), weight_(edge.weight_)
     {
-        ++copies;
+        SIMPLE_GRAPH_COUNT(Edge, copies);
     }
 
     Edge &operator=(const Edge<P, W> &edge)
     {
-        ++assigns;
+        SIMPLE_GRAPH_COUNT(Edge, assigns);
         if (this != &edge) {
             idx1_ = edge.idx1_;
             idx2_ = edge.idx2_;
@@ -155,48 +172,46 @@ public:
         return *this;
     }
 
-    Edge(Edge<P, W> &&edge) noexcept(noexcept(std::is_nothrow_move_constructible<W>::value && std::is_nothrow_move_assignable<W>::value))
+    Edge(Edge<P, W> &&edge) noexcept(std::is_nothrow_move_constructible<P>::value)
         : idx1_(edge.idx1_), idx2_(edge.idx2_), params_(std::move(edge.params_)), weight_(edge.weight_)
     {
-        ++moves;
+        SIMPLE_GRAPH_COUNT(Edge, moves);
     }
 
-    Edge &operator=(Edge<P, W> &&edge) noexcept(noexcept(std::is_nothrow_move_constructible<P>::value && std::is_nothrow_move_assignable<P>::value))
+    Edge &operator=(Edge<P, W> &&edge) noexcept(std::is_nothrow_move_assignable<P>::value)
     {
-        ++moves;
+        SIMPLE_GRAPH_COUNT(Edge, moves);
         if (this != &edge) {
             idx1_ = edge.idx1_;
             idx2_ = edge.idx2_;
-            std::swap(params_, edge.params_);
-            std::swap(weight_, edge.weight_);
+            params_ = std::move(edge.params_);
+            weight_ = edge.weight_;
         }
         return *this;
     }
 
-    virtual ~Edge() = default;
+    ~Edge() = default;
 
     vertex_index_t idx1() const { return idx1_; }
     vertex_index_t idx2() const { return idx2_; }
-    P parameters() const { return params_; }
+    const P &parameters() const & { return params_; }
     const W &weight() const { return weight_; }
 
+    /**
+     * Take parameters out of the expiring edge.
+     */
+    P &&parameters() && { return std::move(params_); }
+
     void swap_vertices() { std::swap(idx1_, idx2_); }
 
-/// counters to track down objects manipulations
-public:
-    static int default_creations;
-    static int creations;
-    static int copies;
-    static int moves;
-    static int assigns;
+    /**
+     * Get counters of edge manipulations made by the calling thread.
+     *
+     * @return Counters, all zeros unless SIMPLE_GRAPH_INSTRUMENT is defined.
+     */
+    static ObjectCounters counters() { return instrument::object_counters<Edge>(); }
 
-    static std::string stat()
-    {
-        return "creations: " + std::to_string(default_creations) + " + " + std::to_string(creations)
-                + "; copies: " + std::to_string(copies)
-                + "; moves: " + std::to_string(moves)
-                + "; assigns: " + std::to_string(assigns);
-    }
+    static void reset_counters() { instrument::object_counters<Edge>() = ObjectCounters(); }
 
 private:
     vertex_index_t idx1_;
@@ -205,61 +220,375 @@ private:
     W weight_;
 };
 
-template<typename P, typename W> int Edge<P, W>::default_creations = 0;
-template<typename P, typename W> int Edge<P, W>::creations = 0;
-template<typename P, typename W> int Edge<P, W>::copies = 0;
-template<typename P, typename W> int Edge<P, W>::moves = 0;
-template<typename P, typename W> int Edge<P, W>::assigns = 0;
+/**
+ * Adjacent vertex together with weight of the edge leading to it.
+ *
+ * @tparam W Typename for edge weight.
+ */
+template<typename W>
+struct Neighbour {
+    vertex_index_t idx;
+    W weight;
+};
 
 /**
- * Interface for Graph children iterators.
+ * Forward iterator over packed adjacency arrays.
  *
- * @tparam T Typename of traversed data.
+ * Neighbour indices and edge weights are stored in parallel arrays. Optional array of filter flags marks
+ * temporarily removed edges, they are skipped while iterating.
+ *
+ * @tparam W Typename for edge weight.
  */
-template<typename T>
-class IIterator {
+template<typename W>
+class NeighbourIterator {
 public:
-    virtual ~IIterator() = default;
-    virtual bool operator==(const IIterator<T> &it) const = 0;
-    virtual bool operator!=(const IIterator<T> &it) const = 0;
-    virtual IIterator<T> &operator++() = 0;
-    virtual T &operator*() = 0;
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = Neighbour<W>;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const Neighbour<W>*;
+    using reference = Neighbour<W>;
+
+    NeighbourIterator() : idx_(nullptr), end_(nullptr), weight_(nullptr), filtered_(nullptr) {}
+
+    /**
+     * Constructor.
+     *
+     * @param idx Current position in neighbour indices array.
+     * @param end End of neighbour indices array.
+     * @param weight Current position in weights array.
+     * @param filtered Current position in filter flags array, nullptr if there are no filtered edges.
+     */
+    NeighbourIterator(const vertex_index_t *idx, const vertex_index_t *end, const W *weight,
+            const std::uint8_t *filtered)
+        : idx_(idx), end_(end), weight_(weight), filtered_(filtered)
+    {
+        skip_filtered();
+    }
+
+    Neighbour<W> operator*() const
+    {
+        return {*idx_, *weight_};
+    }
+
+    NeighbourIterator &operator++()
+    {
+        advance();
+        skip_filtered();
+        return *this;
+    }
+
+    NeighbourIterator operator++(int)
+    {
+        NeighbourIterator tmp = *this;
+        ++*this;
+        return tmp;
+    }
+
+    bool operator==(const NeighbourIterator &it) const { return idx_ == it.idx_; }
+    bool operator!=(const NeighbourIterator &it) const { return idx_ != it.idx_; }
+
+private:
+    void advance()
+    {
+        ++idx_;
+        ++weight_;
+        if (filtered_) {
+            ++filtered_;
+        }
+    }
+
+    void skip_filtered()
+    {
+        if (filtered_) {
+            while ((idx_ != end_) && *filtered_) {
+                advance();
+            }
+        }
+    }
+
+private:
+    const vertex_index_t *idx_;
+    const vertex_index_t *end_;
+    const W *weight_;
+    const std::uint8_t *filtered_;
 };
 
+/**
+ * Non-owning view over adjacency of a vertex.
+ *
+ * The view doesn't allocate and stays valid until the graph is modified.
+ *
+ * @tparam W Typename for edge weight.
+ */
+template<typename W>
+class NeighbourRange {
+public:
+    NeighbourRange() = default;
+
+    /**
+     * Constructor.
+     *
+     * @param idx Neighbour indices array.
+     * @param weight Edge weights array.
+     * @param filtered Edge filter flags array, nullptr if filtered edges should not be skipped.
+     * @param size Number of neighbours.
+     */
+    NeighbourRange(const vertex_index_t *idx, const W *weight, const std::uint8_t *filtered, size_t size)
+        : begin_(idx, idx + size, weight, filtered), end_(idx + size, idx + size, weight + size, nullptr) {}
+
+    NeighbourIterator<W> begin() const { return begin_; }
+    NeighbourIterator<W> end() const { return end_; }
+    bool empty() const { return begin_ == end_; }
+
+private:
+    NeighbourIterator<W> begin_;
+    NeighbourIterator<W> end_;
+};
 
 /**
- * Utility class to provide iterator functionality to Graph children.
+ * Edge storage with structure-of-arrays layout.
+ *
+ * Endpoints, weights and parameters of edges are kept in separate parallel arrays indexed by edge
+ * position, so code reading only weights or endpoints doesn't bring edge parameters into cache.
  *
- * @tparam T Typename of traversed data.
+ * @tparam E Typename for edge additional parameters.
+ * @tparam W Typename for edge weight.
  */
-template<typename T>
-class IteratorWrapper {
+template<typename E, typename W>
+class EdgeStore {
 public:
-    explicit IteratorWrapper(std::shared_ptr<IIterator<T>> b) : base_impl(b) {}
+    EdgeStore() : idx1_(), idx2_(), weight_(), params_() {}
 
-    bool operator==(const IteratorWrapper<T> &it) const
+    /**
+     * Constructor.
+     *
+     * @param resource Memory resource to allocate arrays from.
+     */
+    explicit EdgeStore(std::pmr::memory_resource *resource)
+        : idx1_(resource), idx2_(resource), weight_(resource), params_(resource) {}
+
+    size_t size() const { return idx1_.size(); }
+    bool empty() const { return idx1_.empty(); }
+
+    void reserve(size_t size)
+    {
+        idx1_.reserve(size);
+        idx2_.reserve(size);
+        weight_.reserve(size);
+        params_.reserve(size);
+    }
+
+    void clear()
+    {
+        idx1_.clear();
+        idx2_.clear();
+        weight_.clear();
+        params_.clear();
+    }
+
+    /**
+     * Append edge to the storage.
+     *
+     * @param edge Edge to append.
+     */
+    void push_back(Edge<E, W> edge)
     {
-        return base_impl->operator==(*it.base_impl);
+        idx1_.push_back(edge.idx1());
+        idx2_.push_back(edge.idx2());
+        weight_.push_back(edge.weight());
+        params_.push_back(std::move(edge).parameters());
     }
 
-    bool operator!=(const IteratorWrapper<T> &it) const
+    /**
+     * Append edge constructing its parameters in place.
+     *
+     * @param idx1 Source vertex index.
+     * @param idx2 Target vertex index.
+     * @param weight Edge weight.
+     * @param args Arguments of edge parameters constructor.
+     */
+    template<typename... Args>
+    void emplace_back(vertex_index_t idx1, vertex_index_t idx2, W weight, Args &&...args)
     {
-        return !operator==(it);
+        /// Parameters go first, so that exception of their constructor leaves the storage intact.
+        params_.emplace_back(std::forward<Args>(args)...);
+        idx1_.push_back(idx1);
+        idx2_.push_back(idx2);
+        weight_.push_back(weight);
     }
 
-    IteratorWrapper &operator++()
+    void pop_back()
     {
-        base_impl->operator++();
+        idx1_.pop_back();
+        idx2_.pop_back();
+        weight_.pop_back();
+        params_.pop_back();
+    }
+
+    /**
+     * Move edge to another position overwriting the edge there.
+     *
+     * @param from Position of the edge to move.
+     * @param to Position to move the edge to.
+     */
+    void move(size_t from, size_t to)
+    {
+        idx1_[to] = idx1_[from];
+        idx2_[to] = idx2_[from];
+        weight_[to] = weight_[from];
+        params_[to] = std::move(params_[from]);
+    }
+
+    vertex_index_t idx1(size_t pos) const { return idx1_[pos]; }
+    vertex_index_t idx2(size_t pos) const { return idx2_[pos]; }
+    const W &weight(size_t pos) const { return weight_[pos]; }
+    const E &parameters(size_t pos) const { return params_[pos]; }
+
+    /**
+     * Get weights of all edges, indexed by edge position.
+     */
+    const W *weights() const { return weight_.data(); }
+
+private:
+    std::pmr::vector<vertex_index_t> idx1_;
+    std::pmr::vector<vertex_index_t> idx2_;
+    std::pmr::vector<W> weight_;
+    std::pmr::vector<E> params_;
+};
+
+/**
+ * Reference to an edge in EdgeStore, provides the same accessors as Edge.
+ *
+ * Reference stays valid until the graph owning the storage is modified.
+ *
+ * @tparam E Typename for edge additional parameters.
+ * @tparam W Typename for edge weight.
+ */
+template<typename E, typename W>
+class EdgeRef {
+public:
+    EdgeRef(const EdgeStore<E, W> *store, size_t pos) : store_(store), pos_(pos) {}
+
+    vertex_index_t idx1() const { return store_->idx1(pos_); }
+    vertex_index_t idx2() const { return store_->idx2(pos_); }
+    const E &parameters() const { return store_->parameters(pos_); }
+    const W &weight() const { return store_->weight(pos_); }
+
+    /**
+     * Get position of the edge in the storage.
+     */
+    size_t pos() const { return pos_; }
+
+    /**
+     * Make a copy of the edge.
+     */
+    operator Edge<E, W>() const
+    {
+        return Edge<E, W>(idx1(), idx2(), parameters(), weight());
+    }
+
+private:
+    const EdgeStore<E, W> *store_;
+    size_t pos_;
+};
+
+/**
+ * Forward iterator over edges in EdgeStore.
+ *
+ * Optional bitmap indexed by edge position marks temporarily removed edges, they are skipped while
+ * iterating.
+ *
+ * @tparam E Typename for edge additional parameters.
+ * @tparam W Typename for edge weight.
+ */
+template<typename E, typename W>
+class EdgeIterator {
+public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = EdgeRef<E, W>;
+    using difference_type = std::ptrdiff_t;
+    using pointer = void;
+    using reference = EdgeRef<E, W>;
+
+    EdgeIterator() : edges_(nullptr), filtered_(nullptr), pos_(0), size_(0) {}
+
+    /**
+     * Constructor.
+     *
+     * @param edges Edge storage.
+     * @param filtered Filter bitmap, nullptr if there are no filtered edges.
+     * @param pos Current position in the storage.
+     * @param size Number of edges in the storage.
+     */
+    EdgeIterator(const EdgeStore<E, W> *edges, const Bitmap *filtered, size_t pos, size_t size)
+        : edges_(edges), filtered_(filtered), pos_(pos), size_(size)
+    {
+        skip_filtered();
+    }
+
+    reference operator*() const { return EdgeRef<E, W>(edges_, pos_); }
+
+    EdgeIterator &operator++()
+    {
+        ++pos_;
+        skip_filtered();
         return *this;
     }
 
-    T &operator*()
+    EdgeIterator operator++(int)
     {
-        return base_impl->operator*();
+        EdgeIterator tmp = *this;
+        ++*this;
+        return tmp;
     }
 
+    bool operator==(const EdgeIterator &it) const { return pos_ == it.pos_; }
+    bool operator!=(const EdgeIterator &it) const { return pos_ != it.pos_; }
+
+private:
+    void skip_filtered()
+    {
+        if (filtered_ && (pos_ < size_)) {
+            pos_ = filtered_->find_next_clear(pos_);
+        }
+    }
+
+private:
+    const EdgeStore<E, W> *edges_;
+    const Bitmap *filtered_;
+    size_t pos_;
+    size_t size_;
+};
+
+/**
+ * Non-owning view over edges of a graph.
+ *
+ * The view doesn't allocate and stays valid until the graph is modified.
+ *
+ * @tparam E Typename for edge additional parameters.
+ * @tparam W Typename for edge weight.
+ */
+template<typename E, typename W>
+class EdgeRange {
+public:
+    EdgeRange() = default;
+
+    /**
+     * Constructor.
+     *
+     * @param edges Edge storage.
+     * @param filtered Filter bitmap sized to the storage, nullptr if filtered edges should not be skipped.
+     */
+    EdgeRange(const EdgeStore<E, W> *edges, const Bitmap *filtered)
+        : begin_(edges, filtered, 0, edges->size()), end_(edges, nullptr, edges->size(), edges->size()) {}
+
+    EdgeIterator<E, W> begin() const { return begin_; }
+    EdgeIterator<E, W> end() const { return end_; }
+    bool empty() const { return begin_ == end_; }
+
 private:
-    std::shared_ptr<IIterator<T>> base_impl;
+    EdgeIterator<E, W> begin_;
+    EdgeIterator<E, W> end_;
 };
 
 /**
@@ -271,14 +600,12 @@ private:
  */
 template<bool Dir, typename V, typename E, typename W>
 class Graph {
-protected:
-    class EdgesWrapper {
-    public:
-        virtual IteratorWrapper<Edge<E, W>> begin() = 0;
-        virtual IteratorWrapper<Edge<E, W>> end() = 0;
-    };
-
 public:
+    static constexpr bool directed = Dir;
+    using vertex_type = V;
+    using edge_params_type = E;
+    using weight_type = W;
+
     // TODO Add constructor from std::initializer_list.
     virtual ~Graph() = default;
 
@@ -287,12 +614,31 @@ public:
     // TODO Measure performance.
     virtual std::set<vertex_index_t> inbounds(vertex_index_t idx) const = 0;
     virtual std::set<vertex_index_t> outbounds(vertex_index_t idx, int mode) const = 0;
+    virtual NeighbourRange<W> in_neighbours(vertex_index_t idx) const = 0;
+    virtual NeighbourRange<W> out_neighbours(vertex_index_t idx, int mode) const = 0;
 
     virtual const Vertex<V> &vertex(vertex_index_t idx) const = 0;
     virtual size_t vertex_num() const = 0;
 
+    /**
+     * Get upper bound of vertex indices, per-vertex arrays of this size can be indexed by any vertex index.
+     *
+     * @return Maximal vertex index plus one.
+     */
+    virtual vertex_index_t vertex_bound() const
+    {
+        return static_cast<vertex_index_t>(vertex_num());
+    }
+
     virtual void add_edge(Edge<E, W> edge) = 0;
-    virtual const Edge<E, W> &edge(vertex_index_t idx1, vertex_index_t idx2) const = 0;
+    /**
+     * Get edge between vertices.
+     *
+     * @param idx1 Source vertex index.
+     * @param idx2 Target vertex index.
+     * @return Reference to the edge, valid until the graph is modified.
+     */
+    virtual EdgeRef<E, W> edge(vertex_index_t idx1, vertex_index_t idx2) const = 0;
     virtual bool edge_exists(Edge<E, W> edge) const = 0;
     virtual void rm_edge(Edge<E, W> edge) = 0;
     virtual size_t edge_num() const = 0;
@@ -303,8 +649,12 @@ public:
     virtual bool restore_edges(const std::vector<Edge<E, W>> &edges) = 0;
     virtual void restore_edges() = 0;
 
-    // FIXME
-    virtual EdgesWrapper &edges() = 0;
+    /**
+     * Get all edges of the graph, filtered edges are skipped.
+     *
+     * @return View over edges, each undirected edge is visited once.
+     */
+    virtual EdgeRange<E, W> edges() const = 0;
 };
 
 }  // namespace simple_graph
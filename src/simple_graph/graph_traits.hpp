@@ -0,0 +1,94 @@
+#pragma once
+
+#include <type_traits>
+#include <utility>
+#include "graph.hpp"
+
+namespace simple_graph {
+
+/**
+ * Static description of a graph type.
+ *
+ * Graph type must provide `directed` constant and `vertex_type`, `edge_params_type`, `weight_type` member
+ * typenames, the Graph interface and its implementations provide them.
+ *
+ * @tparam G Graph type.
+ */
+template<typename G>
+struct graph_traits {
+    static constexpr bool directed = G::directed;
+    using vertex_type = typename G::vertex_type;
+    using edge_params_type = typename G::edge_params_type;
+    using weight_type = typename G::weight_type;
+};
+
+template<typename G>
+using graph_weight_t = typename graph_traits<G>::weight_type;
+
+/**
+ * Check if type can be searched by algorithms.
+ *
+ * Searchable graph provides `vertex_num()`, `vertex(idx)` with `data()` accessor and `out_neighbours(idx, mode)`
+ * returning a range of items with `idx` and `weight` members. Algorithms are instantiated against the concrete
+ * graph type, so these calls are resolved statically unless the type is the type-erased Graph interface itself.
+ *
+ * @tparam G Graph type.
+ */
+template<typename G, typename = void>
+struct is_graph : std::false_type {};
+
+template<typename G>
+struct is_graph<G, std::void_t<
+        typename G::vertex_type,
+        typename G::weight_type,
+        decltype(std::declval<const G&>().vertex_num()),
+        decltype(std::declval<const G&>().vertex(vertex_index_t()).data()),
+        decltype((*std::declval<const G&>().out_neighbours(vertex_index_t(), 0).begin()).idx),
+        decltype((*std::declval<const G&>().out_neighbours(vertex_index_t(), 0).begin()).weight)>>
+    : std::true_type {};
+
+template<typename G>
+constexpr bool is_graph_v = is_graph<G>::value;
+
+namespace detail {
+
+template<typename G, typename = void>
+struct has_vertex_bound : std::false_type {};
+
+template<typename G>
+struct has_vertex_bound<G, std::void_t<decltype(std::declval<const G&>().vertex_bound())>> : std::true_type {};
+
+}  // namespace detail
+
+/**
+ * Get upper bound of vertex indices of the graph.
+ *
+ * @param g Graph.
+ * @return Result of `vertex_bound()` if the graph provides it, number of vertices otherwise.
+ */
+template<typename G>
+vertex_index_t vertex_bound(const G &g)
+{
+    if constexpr (detail::has_vertex_bound<G>::value) {
+        return g.vertex_bound();
+    }
+    else {
+        return static_cast<vertex_index_t>(g.vertex_num());
+    }
+}
+
+/**
+ * Return type R if G is a searchable graph, used to constrain algorithm templates.
+ */
+template<typename G, typename R>
+using enable_if_graph_t = std::enable_if_t<is_graph_v<G>, R>;
+
+#if defined(__cpp_concepts) && (__cpp_concepts >= 201907L)
+/**
+ * Concept counterpart of is_graph for C++20 code.
+ */
+template<typename G>
+concept SearchableGraph = is_graph_v<G>;
+#endif
+
+}  // namespace simple_graph
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <functional>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+#include "graph.hpp"
+
+namespace simple_graph {
+
+/**
+ * Bidirectional mapping between external vertex identifiers and dense vertex indices.
+ *
+ * Dense indices are assigned in order of insertion starting from 0, so a graph built with them can use
+ * array-based vertex storage and algorithms can index per-vertex arrays directly. Translation happens once
+ * at the boundary, when graph is built and when results are reported.
+ *
+ * @tparam K Typename for external identifiers.
+ * @tparam Hash Hash function for external identifiers.
+ */
+template<typename K, typename Hash = std::hash<K>>
+class IdMap {
+public:
+    size_t size() const { return keys_.size(); }
+
+    void reserve(size_t size)
+    {
+        ids_.reserve(size);
+        keys_.reserve(size);
+    }
+
+    /**
+     * Get dense index of the identifier assigning the next free one if identifier is new.
+     *
+     * @param key External identifier.
+     * @return Dense vertex index.
+     */
+    vertex_index_t insert(const K &key)
+    {
+        auto res = ids_.emplace(key, static_cast<vertex_index_t>(keys_.size()));
+        if (res.second) {
+            keys_.push_back(key);
+        }
+        return res.first->second;
+    }
+
+    /**
+     * Get dense index of the identifier.
+     *
+     * @param key External identifier.
+     * @return Dense vertex index or -1 if identifier is unknown.
+     */
+    vertex_index_t find(const K &key) const
+    {
+        auto it = ids_.find(key);
+        return it == ids_.end() ? -1 : it->second;
+    }
+
+    /**
+     * Get external identifier of the dense index.
+     *
+     * @param idx Dense vertex index.
+     * @return External identifier.
+     */
+    const K &key(vertex_index_t idx) const
+    {
+        if ((idx < 0) || (static_cast<size_t>(idx) >= keys_.size())) {
+            throw std::out_of_range("Vertex index is not presented");
+        }
+        return keys_[idx];
+    }
+
+private:
+    std::unordered_map<K, vertex_index_t, Hash> ids_;
+    std::vector<K> keys_;
+};
+
+}  // namespace simple_graph
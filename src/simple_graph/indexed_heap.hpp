@@ -0,0 +1,221 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <limits>
+#include <vector>
+#include "graph.hpp"
+
+namespace simple_graph {
+
+/**
+ * Min-heap of vertex indices supporting decrease-key.
+ *
+ * Heap nodes are kept in a flat d-ary tree, position of every vertex in the tree is tracked in an array
+ * sized to the number of vertices so that membership check and key update are O(1) and O(log n).
+ *
+ * @tparam K Typename for keys.
+ * @tparam Arity Number of children of a heap node.
+ */
+template<typename K, size_t Arity = 2>
+class IndexedHeap {
+    static_assert(Arity >= 2, "Heap arity must be at least 2.");
+
+public:
+    /**
+     * Constructor.
+     *
+     * @param capacity Upper bound of vertex indices stored in the heap.
+     */
+    explicit IndexedHeap(size_t capacity) : heap_(), pos_(capacity, npos) {}
+
+    bool empty() const { return heap_.empty(); }
+    size_t size() const { return heap_.size(); }
+
+    /**
+     * Make room for vertex indices up to the specified bound.
+     *
+     * @param capacity Upper bound of vertex indices stored in the heap.
+     */
+    void reserve(size_t capacity)
+    {
+        if (pos_.size() < capacity) {
+            pos_.resize(capacity, npos);
+        }
+    }
+
+    /**
+     * Remove all vertices from the heap.
+     *
+     * @note Complexity is proportional to the number of vertices in the heap, not to its capacity.
+     */
+    void clear()
+    {
+        for (const auto &node : heap_) {
+            pos_[node.idx] = npos;
+        }
+        heap_.clear();
+    }
+
+    bool contains(vertex_index_t idx) const
+    {
+        return pos_[idx] != npos;
+    }
+
+    /**
+     * Get key of the vertex.
+     *
+     * @param idx Vertex index, must be in the heap.
+     * @return Current key of the vertex.
+     */
+    const K &key(vertex_index_t idx) const
+    {
+        assert(contains(idx));
+        return heap_[pos_[idx]].key;
+    }
+
+    /**
+     * Get vertex with the minimal key.
+     *
+     * @return Vertex index.
+     */
+    vertex_index_t top() const
+    {
+        assert(!empty());
+        return heap_.front().idx;
+    }
+
+    /**
+     * Add vertex to the heap.
+     *
+     * @param idx Vertex index, must not be in the heap.
+     * @param key Vertex key.
+     */
+    void push(vertex_index_t idx, K key)
+    {
+        assert(!contains(idx));
+        heap_.push_back({key, idx});
+        pos_[idx] = heap_.size() - 1;
+        sift_up(heap_.size() - 1);
+    }
+
+    /**
+     * Decrease key of the vertex.
+     *
+     * @param idx Vertex index, must be in the heap.
+     * @param key New key, must not be greater than the current one.
+     */
+    void decrease(vertex_index_t idx, K key)
+    {
+        assert(contains(idx));
+        assert(!(heap_[pos_[idx]].key < key));
+        heap_[pos_[idx]].key = key;
+        sift_up(pos_[idx]);
+    }
+
+    /**
+     * Add vertex to the heap or decrease its key if it's already there.
+     *
+     * @param idx Vertex index.
+     * @param key New vertex key.
+     */
+    void update(vertex_index_t idx, K key)
+    {
+        if (contains(idx)) {
+            decrease(idx, key);
+        }
+        else {
+            push(idx, key);
+        }
+    }
+
+    /**
+     * Remove vertex with the minimal key.
+     *
+     * @return Removed vertex index.
+     */
+    vertex_index_t pop()
+    {
+        assert(!empty());
+        vertex_index_t idx = heap_.front().idx;
+        pos_[idx] = npos;
+
+        if (heap_.size() > 1) {
+            heap_.front() = heap_.back();
+            pos_[heap_.front().idx] = 0;
+            heap_.pop_back();
+            sift_down(0);
+        }
+        else {
+            heap_.pop_back();
+        }
+
+        return idx;
+    }
+
+private:
+    static constexpr size_t npos = std::numeric_limits<size_t>::max();
+
+    struct Node {
+        K key;
+        vertex_index_t idx;
+    };
+
+    void sift_up(size_t i)
+    {
+        Node node = heap_[i];
+        while (i > 0) {
+            size_t parent = (i - 1) / Arity;
+            if (!(node.key < heap_[parent].key)) {
+                break;
+            }
+            heap_[i] = heap_[parent];
+            pos_[heap_[i].idx] = i;
+            i = parent;
+        }
+        heap_[i] = node;
+        pos_[node.idx] = i;
+    }
+
+    void sift_down(size_t i)
+    {
+        Node node = heap_[i];
+        size_t size = heap_.size();
+        while (true) {
+            size_t first = i * Arity + 1;
+            if (first >= size) {
+                break;
+            }
+
+            size_t last = std::min(first + Arity, size);
+            size_t min = first;
+            for (size_t c = first + 1; c < last; ++c) {
+                if (heap_[c].key < heap_[min].key) {
+                    min = c;
+                }
+            }
+
+            if (!(heap_[min].key < node.key)) {
+                break;
+            }
+            heap_[i] = heap_[min];
+            pos_[heap_[i].idx] = i;
+            i = min;
+        }
+        heap_[i] = node;
+        pos_[node.idx] = i;
+    }
+
+private:
+    std::vector<Node> heap_;
+    std::vector<size_t> pos_;
+};
+
+template<typename K>
+using BinaryHeap = IndexedHeap<K, 2>;
+
+template<typename K>
+using QuaternaryHeap = IndexedHeap<K, 4>;
+
+}  // namespace simple_graph
@@ -0,0 +1,158 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+/**
+ * Instrumentation of the library, enabled by defining SIMPLE_GRAPH_INSTRUMENT.
+ *
+ * When enabled, constructors and assignments of Vertex and Edge are counted and
+ * SIMPLE_GRAPH_DEFINE_ALLOCATION_HOOKS replaces global operator new and delete with counting ones. All counters
+ * are per-thread, so they are race-free and counts of concurrent queries don't mix. When disabled, counting
+ * compiles to nothing and all counters read as zeros.
+ */
+
+namespace simple_graph {
+
+/**
+ * Counters of object manipulations.
+ */
+struct ObjectCounters {
+    std::uint64_t default_creations = 0;
+    std::uint64_t creations = 0;
+    std::uint64_t copies = 0;
+    std::uint64_t moves = 0;
+    std::uint64_t assigns = 0;
+
+    ObjectCounters operator-(const ObjectCounters &c) const
+    {
+        return {default_creations - c.default_creations, creations - c.creations, copies - c.copies,
+                moves - c.moves, assigns - c.assigns};
+    }
+};
+
+/**
+ * Counters of heap allocations.
+ */
+struct AllocationCounters {
+    std::uint64_t allocations = 0;
+    std::uint64_t deallocations = 0;
+    /// Total size of allocated blocks, freed blocks are not subtracted.
+    std::uint64_t allocated_bytes = 0;
+
+    AllocationCounters operator-(const AllocationCounters &c) const
+    {
+        return {allocations - c.allocations, deallocations - c.deallocations, allocated_bytes - c.allocated_bytes};
+    }
+};
+
+namespace instrument {
+
+#if defined(SIMPLE_GRAPH_INSTRUMENT)
+constexpr bool enabled = true;
+#else
+constexpr bool enabled = false;
+#endif
+
+/**
+ * Get object counters of the calling thread.
+ *
+ * @tparam T Typename of counted objects.
+ */
+template<typename T>
+ObjectCounters &object_counters()
+{
+    static thread_local ObjectCounters counters;
+    return counters;
+}
+
+/**
+ * Get allocation counters of the calling thread, they are updated only if allocation hooks are defined.
+ */
+inline AllocationCounters &allocation_counters()
+{
+    static thread_local AllocationCounters counters;
+    return counters;
+}
+
+/**
+ * Heap allocations made by the calling thread during lifetime of the scope.
+ *
+ * Wrap an algorithm call into a scope to get allocations of that call:
+ *
+ *     instrument::AllocationScope scope;
+ *     dijkstra(g, start, pred, &path, &context);
+ *     AllocationCounters counters = scope.counters();
+ */
+class AllocationScope {
+public:
+    AllocationScope() : start_(allocation_counters()) {}
+
+    AllocationCounters counters() const
+    {
+        return allocation_counters() - start_;
+    }
+
+private:
+    AllocationCounters start_;
+};
+
+}  // namespace instrument
+
+}  // namespace simple_graph
+
+#if defined(SIMPLE_GRAPH_INSTRUMENT)
+
+/**
+ * Count object manipulation.
+ *
+ * @param T Typename of the object.
+ * @param counter Name of ObjectCounters field.
+ */
+#define SIMPLE_GRAPH_COUNT(T, counter) (++::simple_graph::instrument::object_counters<T>().counter)
+
+/**
+ * Replace global operator new and delete with ones counting allocations, must be used in exactly one
+ * translation unit of a program.
+ */
+#define SIMPLE_GRAPH_DEFINE_ALLOCATION_HOOKS \
+    void *operator new(std::size_t size) \
+    { \
+        auto &counters = ::simple_graph::instrument::allocation_counters(); \
+        ++counters.allocations; \
+        counters.allocated_bytes += size; \
+        if (void *p = std::malloc(size ? size : 1)) { \
+            return p; \
+        } \
+        throw std::bad_alloc(); \
+    } \
+    void *operator new(std::size_t size, std::align_val_t align) \
+    { \
+        auto &counters = ::simple_graph::instrument::allocation_counters(); \
+        ++counters.allocations; \
+        counters.allocated_bytes += size; \
+        std::size_t alignment = static_cast<std::size_t>(align); \
+        if (void *p = std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment)) { \
+            return p; \
+        } \
+        throw std::bad_alloc(); \
+    } \
+    void operator delete(void *p) noexcept \
+    { \
+        if (p) { \
+            ++::simple_graph::instrument::allocation_counters().deallocations; \
+            std::free(p); \
+        } \
+    } \
+    void operator delete(void *p, std::size_t) noexcept { operator delete(p); } \
+    void operator delete(void *p, std::align_val_t) noexcept { operator delete(p); } \
+    void operator delete(void *p, std::size_t, std::align_val_t) noexcept { operator delete(p); }
+
+#else
+
+#define SIMPLE_GRAPH_COUNT(T, counter) ((void) 0)
+#define SIMPLE_GRAPH_DEFINE_ALLOCATION_HOOKS
+
+#endif
@@ -2,246 +2,397 @@
 
 #include <algorithm>
 #include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
 #include <stdexcept>
 #include <map>
-#include <unordered_map>  // TODO Replace with something really fast.
+#include <memory_resource>
+#include <unordered_map>
 #include <set>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "edge_index.hpp"
 #include "graph.hpp"
+#include "sort.hpp"
+#include "small_vector.hpp"
+#include "vertex_map.hpp"
 
 namespace simple_graph {
 
-template <bool Dir, typename V, typename E, typename W>
-class ListGraph : public Graph<Dir, V, E, W> {
-    using Edges = std::unordered_map<vertex_index_t, std::unordered_map<vertex_index_t, Edge<E, W>>>;
-    using FilteredEdges = std::unordered_map<vertex_index_t, std::set<vertex_index_t>>;
+template<bool Dir, typename V, typename E, typename W>
+class CsrGraph;
+
+/**
+ * Mutable graph based on adjacency lists.
+ *
+ * @tparam Dir
+ * @tparam V
+ * @tparam E
+ * @tparam W
+ * @tparam Dense Flag indicating that per-vertex data is stored in arrays indexed by vertex index instead of
+ *         hash tables, suitable when vertex indices are dense (see IdMap).
+ */
+template <bool Dir, typename V, typename E, typename W, bool Dense = false>
+class ListGraph final : public Graph<Dir, V, E, W> {
+    template<typename T>
+    using VertexMap = typename std::conditional<Dense, DenseVertexMap<T>, SparseVertexMap<T>>::type;
+    using FilteredEdges = std::pmr::unordered_map<vertex_index_t, std::pmr::set<vertex_index_t>>;
+
+    static constexpr size_t no_edge = EdgeIndex::npos;
 
 private:
     /**
-     * Service class to implement iterator.
+     * Adjacency list of a vertex.
+     *
+     * Neighbour indices are kept sorted in ascending order, edge weights and filter flags are stored
+     * in parallel arrays so that traversal is a contiguous scan. Arrays of low-degree vertices are stored
+     * inline without separate allocations. Adjacency is allocator-aware, so containers of the graph pass
+     * their memory resource to it.
      */
-    class ListEdgesWrapper : public Graph<Dir, V, E, W>::EdgesWrapper {
-    private:
-        /**
-         * Iterator implementation for edges.
-         */
-        class EdgeIterator : public IIterator<Edge<E, W>> {
-            using Iterator1 = typename Edges::iterator;
-            using Iterator2 = typename Edges::mapped_type::iterator;
-
-        public:
-            /**
-             * Constructor.
-             *
-             * @param edges All edges in the graph.
-             * @param filtered_edges All filtered edges in the graph.
-             * @param is_end Flag indicating that iterator traversed all edges.
-             */
-            EdgeIterator(Edges *edges, FilteredEdges *filtered_edges, bool is_end)
-                : edges_(edges), filtered_edges_(filtered_edges), is_end_(is_end)
-            {
-                if (is_end_) {
-                    return;
-                }
+    struct Adjacency {
+        static constexpr size_t inline_capacity = 4;
 
-                // TODO Use const_iterator.
-                it1_ = edges_->begin();
-                if (it1_ == edges_->end()) {
-                    is_end_ = true;
-                }
-                else {
-                    it2_ = it1_->second.begin();
-                    assert(it2_ != it1_->second.end());
-                }
-
-                // FIXME
-                if (!is_end_ && (filtered_edges_->count(it2_->second.idx1()) > 0)
-                        && (filtered_edges_->at(it2_->second.idx1()).count(it2_->second.idx2()) > 0)) {
-                    this->operator++();
-                }
-            }
+        template<typename T>
+        using Array = SmallVector<T, inline_capacity, std::pmr::polymorphic_allocator<T>>;
+        using allocator_type = std::pmr::polymorphic_allocator<std::byte>;
 
-            /**
-             * Check if two iterators are equal to each other.
-             *
-             * @param it Iterator to compare with.
-             * @return True if iterators contain the same edge, false otherwise.
-             */
-            bool operator==(const IIterator<Edge<E, W>> &it) const override
-            {
-                const auto *tmp = dynamic_cast<const EdgeIterator*>(&it);
-                return tmp && is_end_ == tmp->is_end_;
-            }
+        Adjacency() = default;
+        Adjacency(const Adjacency &) = default;
+        Adjacency(Adjacency &&) = default;
+        Adjacency &operator=(const Adjacency &) = default;
+        Adjacency &operator=(Adjacency &&) = default;
 
-            /**
-             * Check if two iterators differ from each other.
-             *
-             * @param it Iterator to compare with.
-             * @return True if iterators differ, false otherwise.
-             */
-            bool operator!=(const IIterator<Edge<E, W>> &it) const override
-            {
-                return !this->operator==(it);
-            }
+        explicit Adjacency(const allocator_type &alloc) : idx(alloc), weight(alloc), filtered(alloc) {}
 
-            /**
-             * Increment iterator.
-             *
-             * @return Reference to iterator itself.
-             */
-            IIterator<Edge<E, W>> &operator++() override
-            {
-                if (is_end_) {
-                    return *this;
-                }
+        Adjacency(const Adjacency &a, const allocator_type &alloc)
+            : idx(a.idx, alloc), weight(a.weight, alloc), filtered(a.filtered, alloc), filtered_num(a.filtered_num) {}
 
-                /// Loop is needed to ignore filtered edges.
-                while (!is_end_) {
-                    ++it2_;
-
-                    /// Traversed all edges for an index, go to next index.
-                    if (it2_ == it1_->second.end()) {
-                        ++it1_;
-                        if (it1_ != edges_->end()) {
-                            it2_ = it1_->second.begin();
-                            assert(it2_ != it1_->second.end());
-                        }
-                        /// Traversed all edges.
-                        else {
-                            is_end_ = true;
-                        }
-                    }
+        Adjacency(Adjacency &&a, const allocator_type &alloc)
+            : idx(std::move(a.idx), alloc), weight(std::move(a.weight), alloc),
+              filtered(std::move(a.filtered), alloc), filtered_num(a.filtered_num) {}
 
-                    /// Ignore filtered edges.
-                    if (!is_end_ && (filtered_edges_->count(it2_->second.idx1()) > 0)
-                            && (filtered_edges_->at(it2_->second.idx1()).count(it2_->second.idx2()) > 0)) {
-                        continue;
-                    }
+        Array<vertex_index_t> idx;
+        Array<W> weight;
+        Array<std::uint8_t> filtered;
+        size_t filtered_num = 0;
 
-                    return *this;
-                }
+        /**
+         * Get view over neighbours.
+         *
+         * @param skip_filtered Flag indicating that filtered edges should be skipped.
+         * @return Range of neighbours.
+         */
+        NeighbourRange<W> range(bool skip_filtered) const
+        {
+            const std::uint8_t *flags = (skip_filtered && (filtered_num > 0)) ? filtered.data() : nullptr;
+            return NeighbourRange<W>(idx.data(), weight.data(), flags, idx.size());
+        }
 
-                return *this;
+        /**
+         * Find position of the neighbour.
+         *
+         * @param idx2 Neighbour index.
+         * @return Position in arrays or size of arrays if there is no such neighbour.
+         */
+        size_t find(vertex_index_t idx2) const
+        {
+            auto it = std::lower_bound(idx.begin(), idx.end(), idx2);
+            if ((it == idx.end()) || (*it != idx2)) {
+                return idx.size();
             }
+            return static_cast<size_t>(it - idx.begin());
+        }
 
-            /**
-             * Get underlying edge.
-             *
-             * @return Current edge.
-             */
-            Edge<E, W> &operator*() override
-            {
-                return it2_->second;
+        void insert(vertex_index_t idx2, W w, bool is_filtered)
+        {
+            auto it = std::lower_bound(idx.begin(), idx.end(), idx2);
+            if ((it != idx.end()) && (*it == idx2)) {
+                return;
             }
+            auto pos = it - idx.begin();
+            idx.insert(it, idx2);
+            weight.insert(weight.begin() + pos, w);
+            filtered.insert(filtered.begin() + pos, is_filtered);
+            filtered_num += is_filtered;
+        }
 
-        private:
-            Edges *edges_;
-            FilteredEdges *filtered_edges_;
-            bool is_end_;
-            Iterator1 it1_;
-            Iterator2 it2_;
-        };
+        /**
+         * Insert several neighbours at once.
+         *
+         * @param idx2 Neighbour indices in ascending order, none of them is in the list.
+         * @param w Edge weights.
+         * @param flags Filter flags of edges.
+         * @param n Number of neighbours.
+         */
+        void merge(const vertex_index_t *idx2, const W *w, const std::uint8_t *flags, size_t n)
+        {
+            size_t i = idx.size();
+            size_t k = i + n;
+            idx.resize(k);
+            weight.resize(k);
+            filtered.resize(k);
+
+            /// Merge from the back, so every element is moved once.
+            for (size_t j = n; j > 0; ) {
+                --k;
+                if ((i > 0) && (idx[i - 1] > idx2[j - 1])) {
+                    --i;
+                    idx[k] = idx[i];
+                    weight[k] = weight[i];
+                    filtered[k] = filtered[i];
+                }
+                else {
+                    --j;
+                    idx[k] = idx2[j];
+                    weight[k] = w[j];
+                    filtered[k] = flags[j];
+                    filtered_num += flags[j];
+                }
+            }
+        }
 
-    public:
-        explicit ListEdgesWrapper(Edges *edges, FilteredEdges *filtered_edges)
-            : edges_(edges), filtered_edges_(filtered_edges) {}
+        void erase(vertex_index_t idx2)
+        {
+            size_t pos = find(idx2);
+            if (pos == idx.size()) {
+                return;
+            }
+            filtered_num -= filtered[pos];
+            idx.erase(idx.begin() + pos);
+            weight.erase(weight.begin() + pos);
+            filtered.erase(filtered.begin() + pos);
+            shrink();
+        }
 
-        IteratorWrapper<Edge<E, W>> begin() override
+        /**
+         * Remove all neighbours satisfying predicate.
+         *
+         * @param pred Predicate taking neighbour index.
+         */
+        template<typename Pred>
+        void erase_if(const Pred &pred)
         {
-            IteratorWrapper<Edge<E, W>> iter(std::make_shared<EdgeIterator>(
-                    EdgeIterator(edges_, filtered_edges_, false)));
-            return iter;
+            size_t n = 0;
+            for (size_t i = 0; i < idx.size(); ++i) {
+                if (pred(idx[i])) {
+                    filtered_num -= filtered[i];
+                    continue;
+                }
+                idx[n] = idx[i];
+                weight[n] = weight[i];
+                filtered[n] = filtered[i];
+                ++n;
+            }
+            idx.resize(n);
+            weight.resize(n);
+            filtered.resize(n);
+            shrink();
         }
 
-        IteratorWrapper<Edge<E, W>> end() override
+        /**
+         * Move neighbours back to inline storage once a quarter of heap block is used at most. Shrinking right
+         * at inline capacity would allocate and free a block on every add and remove of one neighbour.
+         */
+        void shrink()
         {
-            IteratorWrapper<Edge<E, W>> iter(std::make_shared<EdgeIterator>(
-                    EdgeIterator(edges_, filtered_edges_, true)));
-            return iter;
+            if (idx.size() <= idx.capacity() / 4) {
+                idx.shrink_to_fit();
+                weight.shrink_to_fit();
+                filtered.shrink_to_fit();
+            }
         }
 
-    private:
-        Edges *edges_;
-        FilteredEdges *filtered_edges_;
+        void set_filtered(vertex_index_t idx2, bool is_filtered)
+        {
+            size_t pos = find(idx2);
+            if ((pos == idx.size()) || (filtered[pos] == is_filtered)) {
+                return;
+            }
+            filtered[pos] = is_filtered;
+            if (is_filtered) {
+                ++filtered_num;
+            }
+            else {
+                --filtered_num;
+            }
+        }
     };
 
 public:
-    ListGraph() : vertex_num_(0), vertices_(), inbounds_(), outbounds_(), edges_(), filtered_edges_(),
-            edges_wrapper_(&edges_, &filtered_edges_) {}
+    ListGraph() : ListGraph(std::pmr::get_default_resource()) {}
+
+    /**
+     * Constructor.
+     *
+     * @param resource Memory resource to allocate all graph storage from, must outlive the graph. With
+     *        std::pmr::monotonic_buffer_resource building does no separate heap allocations and releasing
+     *        the resource frees the whole graph at once.
+     */
+    explicit ListGraph(std::pmr::memory_resource *resource)
+        : vertex_num_(0), vertex_bound_(0), vertices_(resource), inbounds_(resource), outbounds_(resource),
+          edges_(resource), filtered_(resource), edge_ids_(resource), pending_filtered_(resource) {}
 
     void add_vertex(Vertex<V> vertex) override
     {
-        if (vertex.idx() == static_cast<vertex_index_t >(-1)) {
-            throw std::out_of_range("Vertex with invalid index");
-        }
+        vertex_index_t idx = vertex.idx();
+        insert_vertex(idx, std::move(vertex));
+    }
 
-        if (vertices_.count(vertex.idx()) == 0) {
-            ++vertex_num_;
-        }
-        vertices_.emplace(vertex.idx(), std::move(vertex));
-        inbounds_[vertex.idx()] = std::set<vertex_index_t>();
-        outbounds_[vertex.idx()] = std::set<vertex_index_t>();
+    /**
+     * Add vertex constructing its data in place.
+     *
+     * @param idx Vertex index.
+     * @param args Arguments of vertex data constructor.
+     */
+    template<typename... Args>
+    void emplace_vertex(vertex_index_t idx, Args &&...args)
+    {
+        insert_vertex(idx, idx, std::in_place, std::forward<Args>(args)...);
     }
 
+    /**
+     * Remove vertex with all its edges.
+     *
+     * @param idx Vertex index.
+     * @note Takes time proportional to the vertex degree and degrees of its neighbours. Filters of removed edges
+     *       are dropped.
+     */
     void rm_vertex(vertex_index_t idx) override
     {
-        if (vertices_.count(idx) == 0) {
-            // FIXME Exception is highly ineffective.
-            throw std::out_of_range("Vertex index is not presented");
+        rm_vertices({idx});
+    }
+
+    /**
+     * Remove vertices with all their edges in one sweep.
+     *
+     * Adjacency list of every neighbour is compacted once no matter how many of its neighbours are removed.
+     *
+     * @param indices Vertex indices, duplicates are allowed.
+     * @throw std::out_of_range if some vertex is not presented, the graph is not modified then.
+     */
+    void rm_vertices(std::vector<vertex_index_t> indices)
+    {
+        for (vertex_index_t idx : indices) {
+            if (!vertices_.contains(idx)) {
+                // FIXME Exception is highly ineffective.
+                throw std::out_of_range("Vertex index is not presented");
+            }
         }
+        std::sort(indices.begin(), indices.end());
+        indices.erase(std::unique(indices.begin(), indices.end()), indices.end());
+        /// Bitmap is faster than search in the sorted indices, but it's worth building for large batches only.
+        /// Like other scratch arrays it's allocated from the heap rather than from the graph memory resource.
+        Bitmap removed(std::pmr::new_delete_resource());
+        bool use_bitmap = static_cast<size_t>(vertex_bound_) <= 64 * indices.size();
+        if (use_bitmap) {
+            removed.resize(vertex_bound_);
+            for (vertex_index_t idx : indices) {
+                removed.set(idx);
+            }
+        }
+        auto is_removed = [&](vertex_index_t idx) {
+            return use_bitmap ? removed.test(idx) : std::binary_search(indices.begin(), indices.end(), idx);
+        };
 
-        // TODO Use inbounds_ and outbounds_.
-        for (const auto &v : vertices_) {
-            /// Remove edges 'idx -> some_vertex'.
-            if ((edges_.count(idx) > 0) && (edges_.at(idx).count(v.first) > 0)) {
-                rm_edge(edges_.at(idx).at(v.first));
+        /// Surviving neighbours whose outbound and inbound lists refer to removed vertices.
+        std::vector<vertex_index_t> touched_out;
+        std::vector<vertex_index_t> touched_in;
+        for (vertex_index_t idx : indices) {
+            for (vertex_index_t v : outbounds_[idx].idx) {
+                if (!is_removed(v)) {
+                    (Dir ? touched_in : touched_out).push_back(v);
+                }
+                /// Undirected edge between removed vertices is met twice, it's removed from the lesser one.
+                if (Dir || !is_removed(v) || (v >= idx)) {
+                    erase_edge(find_edge(idx, v));
+                }
             }
-            /// Remove edges 'some_vertex -> idx'.
-            if ((edges_.count(v.first) > 0) && (edges_.at(v.first).count(idx) > 0)) {
-                rm_edge(edges_.at(v.first).at(idx));
+            if (Dir) {
+                for (vertex_index_t u : inbounds_[idx].idx) {
+                    if (!is_removed(u)) {
+                        touched_out.push_back(u);
+                        erase_edge(find_edge(u, idx));
+                    }
+                }
             }
         }
 
-        vertices_.erase(idx);
-        assert(vertex_num_ > 0);
-        --vertex_num_;
-    }
+        compact_adjacency(&outbounds_, &touched_out, is_removed);
+        compact_adjacency(&inbounds_, &touched_in, is_removed);
 
-    std::set<vertex_index_t> inbounds(vertex_index_t idx) const override
-    {
-        if (inbounds_.count(idx) == 0) {
-            return {};
+        for (vertex_index_t idx : indices) {
+            if (Dir) {
+                inbounds_.erase(idx);
+            }
+            outbounds_.erase(idx);
+            vertices_.erase(idx);
         }
+        assert(vertex_num_ >= static_cast<vertex_index_t>(indices.size()));
+        vertex_num_ -= static_cast<vertex_index_t>(indices.size());
 
-        std::set<vertex_index_t> res;
-        for (const auto &idx2 : inbounds_.at(idx)) {
-            if ((filtered_edges_.count(idx2) == 0) || (filtered_edges_.at(idx2).count(idx) == 0)) {
-                res.insert(idx2);
+        for (auto it = pending_filtered_.begin(); it != pending_filtered_.end(); ) {
+            if (is_removed(it->first)) {
+                it = pending_filtered_.erase(it);
+                continue;
             }
+            auto &targets = it->second;
+            for (auto jt = targets.begin(); jt != targets.end(); ) {
+                jt = is_removed(*jt) ? targets.erase(jt) : std::next(jt);
+            }
+            it = targets.empty() ? pending_filtered_.erase(it) : std::next(it);
         }
+    }
 
+    std::set<vertex_index_t> inbounds(vertex_index_t idx) const override
+    {
+        std::set<vertex_index_t> res;
+        for (const auto &n : in_neighbours(idx)) {
+            res.insert(res.end(), n.idx);
+        }
         return res;
     }
 
     std::set<vertex_index_t> outbounds(vertex_index_t idx, int mode) const override
     {
-        if (outbounds_.count(idx) == 0) {
-            return {};
+        std::set<vertex_index_t> res;
+        for (const auto &n : out_neighbours(idx, mode)) {
+            res.insert(res.end(), n.idx);
         }
+        return res;
+    }
 
-        /// No filters were applied, return all outbounds.
-        if ((mode == 1) || (filtered_edges_.count(idx) == 0)) {
-            return outbounds_.at(idx);
+    /**
+     * Get vertices with edges leading to the specified vertex.
+     *
+     * @param idx Vertex index.
+     * @return View over inbound neighbours, filtered edges are skipped.
+     */
+    NeighbourRange<W> in_neighbours(vertex_index_t idx) const override
+    {
+        /// Undirected graph is symmetric, inbounds are the same as outbounds.
+        const Adjacency *adjacency = Dir ? inbounds_.find(idx) : outbounds_.find(idx);
+        if (!adjacency) {
+            return {};
         }
+        return adjacency->range(true);
+    }
 
-        /// Return all outbounds except filtered ones.
-        std::set<vertex_index_t> res;
-        for (const auto &idx2 : outbounds_.at(idx)) {
-            if (filtered_edges_.at(idx).count(idx2) == 0) {
-                res.insert(idx2);
-            }
+    /**
+     * Get vertices reachable from the specified vertex by one edge.
+     *
+     * @param idx Vertex index.
+     * @param mode 1 to include filtered edges, 0 to skip them.
+     * @return View over outbound neighbours.
+     */
+    NeighbourRange<W> out_neighbours(vertex_index_t idx, int mode) const override
+    {
+        const Adjacency *adjacency = outbounds_.find(idx);
+        if (!adjacency) {
+            return {};
         }
-
-        return res;
+        return adjacency->range(mode != 1);
     }
 
     const Vertex<V> &vertex(vertex_index_t idx) const override
@@ -251,53 +402,134 @@ public:
 
     size_t vertex_num() const override { return vertex_num_; };
 
+    /**
+     * Get upper bound of vertex indices.
+     *
+     * @return Maximal index of ever added vertex plus one.
+     */
+    vertex_index_t vertex_bound() const override { return vertex_bound_; }
+
     void add_edge(Edge<E, W> edge) override
     {
-        if ((vertices_.count(edge.idx1()) == 0) || (vertices_.count(edge.idx2()) == 0)) {
-            throw std::out_of_range("Vertex index is not presented");
+        vertex_index_t idx1 = edge.idx1();
+        vertex_index_t idx2 = edge.idx2();
+        if (check_new_edge(&idx1, &idx2)) {
+            edges_.emplace_back(idx1, idx2, edge.weight(), std::move(edge).parameters());
+            link_edge(edges_.size() - 1);
         }
-        inbounds_[edge.idx2()].insert(edge.idx1());
-        outbounds_[edge.idx1()].insert(edge.idx2());
-        if (!Dir) {
-            inbounds_[edge.idx1()].insert(edge.idx2());
-            outbounds_[edge.idx2()].insert(edge.idx1());
+    }
+
+    /**
+     * Add edge constructing its parameters in place.
+     *
+     * @param idx1 Source vertex index.
+     * @param idx2 Target vertex index.
+     * @param weight Edge weight.
+     * @param args Arguments of edge parameters constructor.
+     */
+    template<typename... Args>
+    void emplace_edge(vertex_index_t idx1, vertex_index_t idx2, W weight, Args &&...args)
+    {
+        if (check_new_edge(&idx1, &idx2)) {
+            edges_.emplace_back(idx1, idx2, weight, std::forward<Args>(args)...);
+            link_edge(edges_.size() - 1);
         }
+    }
 
-        /// Store undirected edge as min_idx->max_idx.
-        if (!Dir && (edge.idx1() > edge.idx2())) {
-            edge.swap_vertices();
+    /**
+     * Add batch of edges.
+     *
+     * Batch is sorted once instead of per-edge lookups and inserts, adjacency lists get all their new
+     * neighbours in a single merge. Result is the same as of add_edge() called for every edge of the batch:
+     * duplicates and edges already in the graph are skipped, new edges are stored in batch order.
+     *
+     * @param edges Edges to add.
+     * @throw std::out_of_range if some edge has absent vertex, the graph is not modified then.
+     */
+    void add_edges(std::vector<Edge<E, W>> edges)
+    {
+        for (auto &edge : edges) {
+            if (!vertices_.contains(edge.idx1()) || !vertices_.contains(edge.idx2())) {
+                throw std::out_of_range("Vertex index is not presented");
+            }
+            if (!Dir && (edge.idx1() > edge.idx2())) {
+                edge.swap_vertices();
+            }
+        }
+
+        std::vector<BatchEntry> entries;
+        entries.reserve(edges.size());
+        for (size_t pos = 0; pos < edges.size(); ++pos) {
+            entries.push_back({edges[pos].idx1(), edges[pos].idx2(), pos, edges[pos].weight(), false});
+        }
+        sort_batch(&entries);
+
+        /// Filter flag of the edge at the batch position, -1 for skipped edges.
+        std::vector<std::int8_t> flags(edges.size(), -1);
+        size_t n = 0;
+        for (size_t i = 0; i < entries.size(); ++i) {
+            BatchEntry e = entries[i];
+            if ((i > 0) && (e.idx1 == entries[i - 1].idx1) && (e.idx2 == entries[i - 1].idx2)) {
+                continue;
+            }
+            if (find_edge(e.idx1, e.idx2) != no_edge) {
+                continue;
+            }
+            e.filtered = !pending_filtered_.empty() && take_pending_filter(e.idx1, e.idx2);
+            flags[e.pos] = e.filtered;
+            entries[n++] = e;
         }
+        entries.resize(n);
 
-        auto idx2 = edge.idx2(); /// Make idx2 copy as edge will be moved.
-        edges_[edge.idx1()].emplace(idx2, std::move(edge));
+        merge_adjacency(&outbounds_, entries);
+        for (auto &e : entries) {
+            std::swap(e.idx1, e.idx2);
+        }
+        if (!Dir) {
+            /// Self-loop is already in the outbounds.
+            entries.erase(std::remove_if(entries.begin(), entries.end(),
+                    [](const BatchEntry &e) { return e.idx1 == e.idx2; }), entries.end());
+        }
+        sort_batch(&entries);
+        merge_adjacency(Dir ? &inbounds_ : &outbounds_, entries);
+
+        size_t id = edges_.size();
+        edges_.reserve(id + n);
+        edge_ids_.reserve(id + n);
+        filtered_.resize(id + n);
+        for (size_t pos = 0; pos < edges.size(); ++pos) {
+            if (flags[pos] < 0) {
+                continue;
+            }
+            edge_ids_.insert(edges[pos].idx1(), edges[pos].idx2(), id);
+            filtered_.assign(id, flags[pos]);
+            edges_.push_back(std::move(edges[pos]));
+            ++id;
+        }
     }
 
-    const Edge<E, W> &edge(vertex_index_t idx1, vertex_index_t idx2) const override
+    EdgeRef<E, W> edge(vertex_index_t idx1, vertex_index_t idx2) const override
     {
-        if (Dir) {
-            return edges_.at(idx1).at(idx2);
-        }
-        else {
-            auto p = std::minmax(idx1, idx2);
-            return edges_.at(p.first).at(p.second);
+        size_t id = find_edge(idx1, idx2);
+        if (id == no_edge) {
+            throw std::out_of_range("Edge is not presented");
         }
+        return EdgeRef<E, W>(&edges_, id);
     }
 
     bool edge_exists(Edge<E, W> edge) const override
     {
-        if (!Dir && (edge.idx1() > edge.idx2())) {
-            edge.swap_vertices();
-        }
-        return (edges_.count(edge.idx1()) > 0) && (edges_.at(edge.idx1()).count(edge.idx2()) > 0);
+        return find_edge(edge.idx1(), edge.idx2()) != no_edge;
     }
 
     /**
      * @brief Remove specified edge from the graph
      * @param edge Edge to remove.
+     * @note Last edge in the storage takes place of the removed one.
      */
     void rm_edge(Edge<E, W> edge) override
     {
-        if ((vertices_.count(edge.idx1()) == 0) || (vertices_.count(edge.idx2()) == 0)) {
+        if (!vertices_.contains(edge.idx1()) || !vertices_.contains(edge.idx2())) {
             throw std::out_of_range("Vertex index is not presented");
         }
 
@@ -305,24 +537,25 @@ public:
             edge.swap_vertices();
         }
 
-        if ((edges_.count(edge.idx1()) == 0) || (edges_.at(edge.idx1()).count(edge.idx2()) == 0)) {
+        size_t id = find_edge(edge.idx1(), edge.idx2());
+        if (id == no_edge) {
             return;
         }
 
-        outbounds_[edge.idx1()].erase(edge.idx2());
-        if (!Dir) {
-            outbounds_[edge.idx2()].erase(edge.idx1());
+        /// Filter outlives the edge and applies if the edge is added again.
+        if (filtered_.test(id)) {
+            pending_filtered_[edge.idx1()].insert(edge.idx2());
         }
 
-        inbounds_[edge.idx2()].erase(edge.idx1());
-        if (!Dir) {
-            inbounds_[edge.idx1()].erase(edge.idx2());
+        outbounds_[edge.idx1()].erase(edge.idx2());
+        if (Dir) {
+            inbounds_[edge.idx2()].erase(edge.idx1());
         }
-
-        edges_[edge.idx1()].erase(edge.idx2());
-        if (edges_[edge.idx1()].size() == 0) {
-            edges_.erase(edge.idx1());
+        else {
+            outbounds_[edge.idx2()].erase(edge.idx1());
         }
+
+        erase_edge(id);
     }
 
     /**
@@ -331,7 +564,7 @@ public:
      * @return Number of edges.
      * @note Filtered edges are not taken into consideration.
      */
-    size_t edge_num() const
+    size_t edge_num() const override
     {
         return edges_.size();
     }
@@ -344,9 +577,7 @@ public:
      */
     bool filter_edge(Edge<E, W> edge) override
     {
-        bool rc = true;
-
-        if ((vertices_.count(edge.idx1()) == 0) || (vertices_.count(edge.idx2()) == 0)) {
+        if (!vertices_.contains(edge.idx1()) || !vertices_.contains(edge.idx2())) {
             throw std::out_of_range("Vertex index is not presented");
         }
 
@@ -354,14 +585,18 @@ public:
             edge.swap_vertices();
         }
 
-        filtered_edges_[edge.idx1()].insert(edge.idx2());
+        size_t id = find_edge(edge.idx1(), edge.idx2());
+        if (id == no_edge) {
+            pending_filtered_[edge.idx1()].insert(edge.idx2());
+            return false;
+        }
 
-        /// Check if edge was actually filtered out.
-        if (!edges_.count(edge.idx1()) || !edges_.at(edge.idx1()).count(edge.idx2())) {
-            rc = false;
+        if (!filtered_.test(id)) {
+            filtered_.set(id);
+            set_filtered(edge.idx1(), edge.idx2(), true);
         }
 
-        return rc;
+        return true;
     }
 
     /**
@@ -388,7 +623,7 @@ public:
      */
     bool restore_edge(Edge<E, W> edge) override
     {
-        if ((vertices_.count(edge.idx1()) == 0) || (vertices_.count(edge.idx2()) == 0)) {
+        if (!vertices_.contains(edge.idx1()) || !vertices_.contains(edge.idx2())) {
             throw std::out_of_range("Vertex index is not presented");
         }
 
@@ -396,15 +631,14 @@ public:
             edge.swap_vertices();
         }
 
-        if ((filtered_edges_.count(edge.idx1()) > 0) && (filtered_edges_.at(edge.idx1()).count(edge.idx2()) > 0)) {
-            filtered_edges_[edge.idx1()].erase(edge.idx2());
-            if (filtered_edges_.at(edge.idx1()).size() == 0) {
-                filtered_edges_.erase(edge.idx1());
-            }
+        size_t id = find_edge(edge.idx1(), edge.idx2());
+        if ((id != no_edge) && filtered_.test(id)) {
+            filtered_.reset(id);
+            set_filtered(edge.idx1(), edge.idx2(), false);
             return true;
         }
 
-        return false;
+        return take_pending_filter(edge.idx1(), edge.idx2());
     }
 
     /**
@@ -430,26 +664,273 @@ public:
      */
     void restore_edges() override
     {
-        filtered_edges_.clear();
+        for (size_t id = 0; !filtered_.none() && (id < edges_.size()); ++id) {
+            if (filtered_.test(id)) {
+                filtered_.reset(id);
+                set_filtered(edges_.idx1(id), edges_.idx2(id), false);
+            }
+        }
+        pending_filtered_.clear();
+    }
+
+    /**
+     * Get all edges of the graph.
+     *
+     * @return View over edges, filtered edges are skipped.
+     */
+    EdgeRange<E, W> edges() const override
+    {
+        return EdgeRange<E, W>(&edges_, filtered_.none() ? nullptr : &filtered_);
+    }
+
+private:
+    friend class CsrGraph<Dir, V, E, W>;
+
+    /**
+     * Edge of a batch passed to add_edges().
+     */
+    struct BatchEntry {
+        vertex_index_t idx1;
+        vertex_index_t idx2;
+        /// Position of the edge in the batch.
+        size_t pos;
+        /// Weight and filter flag are copied to avoid random access to the batch.
+        W weight;
+        bool filtered;
+
+        /**
+         * Compare by vertex indices, then by batch position so that duplicates stay in batch order.
+         */
+        static bool less(const BatchEntry &a, const BatchEntry &b)
+        {
+            if (a.idx1 != b.idx1) {
+                return a.idx1 < b.idx1;
+            }
+            if (a.idx2 != b.idx2) {
+                return a.idx2 < b.idx2;
+            }
+            return a.pos < b.pos;
+        }
+    };
+
+    /**
+     * Sort batch entries by vertex indices, entries of the same edge are kept in batch order.
+     *
+     * @param entries Batch entries, entries of the same edge must be in batch order.
+     */
+    void sort_batch(std::vector<BatchEntry> *entries) const
+    {
+        size_t bound = static_cast<size_t>(vertex_bound_);
+        /// Counters of sparse vertex indices would take more memory and time than the sort itself.
+        if (bound > 4 * entries->size()) {
+            detail::parallel_sort(entries->begin(), entries->end(), BatchEntry::less);
+            return;
+        }
+
+        /// Radix sort with one digit per vertex index.
+        std::vector<BatchEntry> tmp;
+        detail::counting_sort(*entries, &tmp, bound, [](const BatchEntry &e) { return e.idx2; });
+        detail::counting_sort(tmp, entries, bound, [](const BatchEntry &e) { return e.idx1; });
+    }
+
+    /**
+     * Add neighbours from the batch to adjacency lists.
+     *
+     * @param adjacency Adjacency lists to update.
+     * @param entries Batch entries sorted by vertex indices, `idx1 -> idx2` adds idx2 to the list of idx1.
+     */
+    static void merge_adjacency(VertexMap<Adjacency> *adjacency, const std::vector<BatchEntry> &entries)
+    {
+        std::vector<vertex_index_t> idx;
+        std::vector<W> weight;
+        std::vector<std::uint8_t> filtered;
+        for (size_t first = 0, last = 0; first < entries.size(); first = last) {
+            idx.clear();
+            weight.clear();
+            filtered.clear();
+            for (last = first; (last < entries.size()) && (entries[last].idx1 == entries[first].idx1); ++last) {
+                idx.push_back(entries[last].idx2);
+                weight.push_back(entries[last].weight);
+                filtered.push_back(entries[last].filtered);
+            }
+            (*adjacency)[entries[first].idx1].merge(idx.data(), weight.data(), filtered.data(), idx.size());
+        }
+    }
+
+    /**
+     * Find position of the edge in the storage.
+     *
+     * @param idx1 Source vertex index.
+     * @param idx2 Target vertex index.
+     * @return Edge position or no_edge if there is no such edge.
+     */
+    size_t find_edge(vertex_index_t idx1, vertex_index_t idx2) const
+    {
+        if (!Dir && (idx1 > idx2)) {
+            std::swap(idx1, idx2);
+        }
+        return edge_ids_.find(idx1, idx2);
+    }
+
+    /**
+     * Add vertex if there is no such vertex yet, existing vertex keeps its data and edges.
+     *
+     * @param idx Vertex index.
+     * @param args Arguments of Vertex constructor.
+     */
+    template<typename... Args>
+    void insert_vertex(vertex_index_t idx, Args &&...args)
+    {
+        if (idx == static_cast<vertex_index_t >(-1)) {
+            throw std::out_of_range("Vertex with invalid index");
+        }
+
+        if (!vertices_.emplace(idx, std::forward<Args>(args)...)) {
+            return;
+        }
+        ++vertex_num_;
+        vertex_bound_ = std::max(vertex_bound_, idx + 1);
+        if (Dir) {
+            inbounds_[idx] = Adjacency();
+        }
+        outbounds_[idx] = Adjacency();
     }
 
     /**
+     * Check endpoints of edge being added.
      *
-     * @return
+     * @param idx1 Source vertex index, normalized for undirected graph on return.
+     * @param idx2 Target vertex index, normalized for undirected graph on return.
+     * @return True if there is no such edge yet, false otherwise.
      */
-    typename Graph<Dir, V, E, W>::EdgesWrapper &edges() override
+    bool check_new_edge(vertex_index_t *idx1, vertex_index_t *idx2) const
     {
-        return edges_wrapper_;
+        if (!vertices_.contains(*idx1) || !vertices_.contains(*idx2)) {
+            throw std::out_of_range("Vertex index is not presented");
+        }
+
+        /// Store undirected edge as min_idx->max_idx.
+        if (!Dir && (*idx1 > *idx2)) {
+            std::swap(*idx1, *idx2);
+        }
+
+        return find_edge(*idx1, *idx2) == no_edge;
+    }
+
+    /**
+     * Add edge appended to the storage to adjacency lists and the index.
+     *
+     * @param id Edge position.
+     */
+    void link_edge(size_t id)
+    {
+        vertex_index_t idx1 = edges_.idx1(id);
+        vertex_index_t idx2 = edges_.idx2(id);
+        W weight = edges_.weight(id);
+
+        /// Edge could be filtered out before it was added.
+        bool is_filtered = take_pending_filter(idx1, idx2);
+
+        outbounds_[idx1].insert(idx2, weight, is_filtered);
+        if (Dir) {
+            inbounds_[idx2].insert(idx1, weight, is_filtered);
+        }
+        else {
+            outbounds_[idx2].insert(idx1, weight, is_filtered);
+        }
+
+        edge_ids_.insert(idx1, idx2, id);
+        filtered_.resize(id + 1);
+        filtered_.assign(id, is_filtered);
+    }
+
+    /**
+     * Remove edge from the storage and the index, adjacency lists are left intact.
+     *
+     * @param id Edge position, last edge in the storage takes its place.
+     */
+    void erase_edge(size_t id)
+    {
+        edge_ids_.erase(edges_.idx1(id), edges_.idx2(id));
+
+        size_t last = edges_.size() - 1;
+        if (id != last) {
+            edges_.move(last, id);
+            filtered_.assign(id, filtered_.test(last));
+            edge_ids_.assign(edges_.idx1(id), edges_.idx2(id), id);
+        }
+        edges_.pop_back();
+        filtered_.resize(last);
+    }
+
+    /**
+     * Remove neighbours from adjacency lists.
+     *
+     * @param adjacency Adjacency lists.
+     * @param touched Vertices whose lists are compacted, sorted and deduplicated in place.
+     * @param is_removed Predicate taking index of neighbour to remove.
+     */
+    template<typename Pred>
+    static void compact_adjacency(VertexMap<Adjacency> *adjacency, std::vector<vertex_index_t> *touched,
+            const Pred &is_removed)
+    {
+        std::sort(touched->begin(), touched->end());
+        touched->erase(std::unique(touched->begin(), touched->end()), touched->end());
+        for (vertex_index_t idx : *touched) {
+            adjacency->find(idx)->erase_if(is_removed);
+        }
+    }
+
+    /**
+     * Remove filter of absent edge.
+     *
+     * @param idx1 Source vertex index, normalized for undirected graph.
+     * @param idx2 Target vertex index, normalized for undirected graph.
+     * @return True if there was such filter, false otherwise.
+     */
+    bool take_pending_filter(vertex_index_t idx1, vertex_index_t idx2)
+    {
+        auto it = pending_filtered_.find(idx1);
+        if ((it == pending_filtered_.end()) || (it->second.erase(idx2) == 0)) {
+            return false;
+        }
+        if (it->second.empty()) {
+            pending_filtered_.erase(it);
+        }
+        return true;
+    }
+
+    /**
+     * Update filter flags of the edge in adjacency lists.
+     *
+     * @param idx1 Source vertex index.
+     * @param idx2 Target vertex index.
+     * @param is_filtered New value of the flag.
+     */
+    void set_filtered(vertex_index_t idx1, vertex_index_t idx2, bool is_filtered)
+    {
+        outbounds_[idx1].set_filtered(idx2, is_filtered);
+        if (Dir) {
+            inbounds_[idx2].set_filtered(idx1, is_filtered);
+        }
+        else {
+            outbounds_[idx2].set_filtered(idx1, is_filtered);
+        }
     }
 
 private:
     vertex_index_t vertex_num_;
-    std::unordered_map<vertex_index_t, Vertex<V>> vertices_;
-    std::unordered_map<vertex_index_t, std::set<vertex_index_t>> inbounds_;
-    std::unordered_map<vertex_index_t, std::set<vertex_index_t>> outbounds_;
-    Edges edges_;
-    FilteredEdges filtered_edges_;
-    ListEdgesWrapper edges_wrapper_;
+    vertex_index_t vertex_bound_;
+    VertexMap<Vertex<V>> vertices_;
+    /// Inbound adjacency is kept for directed graphs only, undirected graph uses outbounds instead.
+    VertexMap<Adjacency> inbounds_;
+    VertexMap<Adjacency> outbounds_;
+    /// Edges are stored densely, position of an edge is its id until some edge is removed.
+    EdgeStore<E, W> edges_;
+    Bitmap filtered_;
+    EdgeIndex edge_ids_;
+    /// Filters of edges which are not in the graph yet.
+    FilteredEdges pending_filtered_;
 };
 
 }  // namespace simple_graph
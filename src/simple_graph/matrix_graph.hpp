@@ -1,82 +1,665 @@
 #pragma once
 
 #include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <set>
+#include <stdexcept>
 #include <vector>
+#include "bitmap.hpp"
 #include "graph.hpp"
+#include "vertex_map.hpp"
+
+namespace simple_graph {
+
+/**
+ * Mutable graph based on adjacency matrix packed into bits, suitable for dense graphs.
+ *
+ * Row `idx` of the matrix is a bitmap of vertices reachable from vertex `idx` by one edge, so edge check
+ * is a single bit test and neighbourhoods of several vertices are combined with word-wide bitwise
+ * operations. Rows include filtered edges. Directed graph keeps the transposed matrix as well, its rows are
+ * bitmaps of inbound neighbours.
+ *
+ * Graph interface hands out neighbours as views over contiguous arrays and edges as references into EdgeStore,
+ * so the matrix alone can't serve it: every vertex keeps arrays of its neighbours and edge weights, and edges
+ * are kept in EdgeStore. Neighbours are ordered as bits of the row, position of a neighbour in the arrays is
+ * the number of bits set before it, so edges are found without hash index or binary search and filters are
+ * kept in one more bit matrix. There is no separate weight matrix: traversal needs weights next to neighbour
+ * indices anyway, so a matrix of capacity^2 weights would only add to the arrays.
+ *
+ * @tparam Dir
+ * @tparam V
+ * @tparam E
+ * @tparam W
+ */
+template<bool Dir, typename V, typename E, typename W>
+class MatrixGraph final : public Graph<Dir, V, E, W> {
+    static constexpr size_t no_edge = static_cast<size_t>(-1);
+
+    /**
+     * Neighbours of a vertex in ascending order of their indices, weights and filter flags in parallel arrays.
+     */
+    struct Adjacency {
+        std::vector<vertex_index_t> idx;
+        std::vector<W> weight;
+        std::vector<std::uint8_t> filtered;
+        /// Positions of edges in the storage, kept for outbound neighbours only.
+        std::vector<size_t> edge;
+        size_t filtered_num = 0;
+
+        NeighbourRange<W> range(bool skip_filtered) const
+        {
+            const std::uint8_t *flags = (skip_filtered && (filtered_num > 0)) ? filtered.data() : nullptr;
+            return NeighbourRange<W>(idx.data(), weight.data(), flags, idx.size());
+        }
+
+        void insert(size_t pos, vertex_index_t idx2, W w, bool is_filtered)
+        {
+            idx.insert(idx.begin() + pos, idx2);
+            weight.insert(weight.begin() + pos, w);
+            filtered.insert(filtered.begin() + pos, is_filtered);
+            filtered_num += is_filtered;
+        }
+
+        void erase(size_t pos)
+        {
+            filtered_num -= filtered[pos];
+            idx.erase(idx.begin() + pos);
+            weight.erase(weight.begin() + pos);
+            filtered.erase(filtered.begin() + pos);
+            if (!edge.empty()) {
+                edge.erase(edge.begin() + pos);
+            }
+        }
+
+        void set_filtered(size_t pos, bool is_filtered)
+        {
+            if (filtered[pos] != is_filtered) {
+                filtered[pos] = is_filtered;
+                filtered_num = is_filtered ? filtered_num + 1 : filtered_num - 1;
+            }
+        }
+    };
 
-template <bool Dir, typename V, typename E>
-class MatrixGraph : public Graph<V, E> {
 public:
-    MatrixGraph() : vertex_num_(0), vertices_(), matrix_() {}
-    virtual ~MatrixGraph() = default;
+    MatrixGraph()
+        : vertex_num_(0), vertex_bound_(0), vertices_(), outbounds_(), inbounds_(), matrix_(), in_matrix_(),
+          filter_matrix_(), edges_(), filtered_(), capacity_(0), row_words_(0) {}
+
+    /**
+     * Add vertex, vertex with the same index is left intact.
+     *
+     * @param vertex Vertex to add.
+     */
+    void add_vertex(Vertex<V> vertex) override
+    {
+        vertex_index_t idx = vertex.idx();
+        if (idx < 0) {
+            throw std::out_of_range("Vertex with invalid index");
+        }
+
+        reserve(idx + 1);
+        if (vertices_.emplace(idx, std::move(vertex))) {
+            ++vertex_num_;
+            vertex_bound_ = std::max(vertex_bound_, idx + 1);
+        }
+    }
 
-    virtual int add_vertex(const Vertex<V> &vertex) override {
-        if (vertex.idx() >= vertex_num_) {
-            vertex_num_ = vertex.idx() + 1;
-            matrix_.resize(vertex_num_ * vertex_num_, false);
+    /**
+     * Remove vertex with all its edges.
+     *
+     * @param idx Vertex index.
+     * @note Takes time proportional to the vertex degree times the number of row words. Filters of removed edges
+     *       are dropped.
+     */
+    void rm_vertex(vertex_index_t idx) override
+    {
+        if (!vertices_.contains(idx)) {
+            throw std::out_of_range("Vertex index is not presented");
         }
-        if (vertices_.count(vertex.idx()) != 0) {
-            return -1;
+
+        /// Lists of the vertex itself stay consistent with its rows until both are dropped at the end.
+        std::vector<vertex_index_t> out = outbounds_[idx].idx;
+        for (vertex_index_t v : out) {
+            erase_edge(find_edge(idx, v));
+            if (v != idx) {
+                unlink(Dir ? &inbounds_ : &outbounds_, Dir ? &in_matrix_ : &matrix_, v, idx);
+            }
+        }
+        if (Dir) {
+            std::vector<vertex_index_t> in = inbounds_[idx].idx;
+            for (vertex_index_t u : in) {
+                if (u != idx) {
+                    erase_edge(find_edge(u, idx));
+                    unlink(&outbounds_, &matrix_, u, idx);
+                }
+            }
+        }
+
+        outbounds_[idx] = Adjacency();
+        std::fill(row_data(&matrix_, idx), row_data(&matrix_, idx) + row_words_, 0);
+        if (Dir) {
+            inbounds_[idx] = Adjacency();
+            std::fill(row_data(&in_matrix_, idx), row_data(&in_matrix_, idx) + row_words_, 0);
+        }
+        std::fill(row_data(&filter_matrix_, idx), row_data(&filter_matrix_, idx) + row_words_, 0);
+        for (vertex_index_t u = 0; u < capacity_; ++u) {
+            reset_bit(&filter_matrix_, u, idx);
+        }
+
+        vertices_.erase(idx);
+        --vertex_num_;
+    }
+
+    std::set<vertex_index_t> inbounds(vertex_index_t idx) const override
+    {
+        std::set<vertex_index_t> res;
+        for (const auto &n : in_neighbours(idx)) {
+            res.insert(res.end(), n.idx);
         }
-        vertices_[vertex.idx()] = vertex;
-        return 0;
+        return res;
     }
 
-    virtual int set_vertex(const Vertex<V> &vertex) override {
-        if (vertex.idx() >= vertex_num_) {
-            vertex_num_ = vertex.idx() + 1;
-            matrix_.resize(vertex_num_ * vertex_num_, false);
+    std::set<vertex_index_t> outbounds(vertex_index_t idx, int mode) const override
+    {
+        std::set<vertex_index_t> res;
+        for (const auto &n : out_neighbours(idx, mode)) {
+            res.insert(res.end(), n.idx);
         }
-        vertices_[vertex.idx()] = vertex;
-        return 0;
+        return res;
     }
 
-    void rm_vertex(const Vertex<V> &vertex) override {
-        if (vertices_.count(vertex.idx()) > 0) {
-            vertices_.erase(vertex.idx());
+    /**
+     * Get vertices having edges to the specified vertex, filtered edges are skipped.
+     *
+     * @param idx Vertex index.
+     */
+    NeighbourRange<W> in_neighbours(vertex_index_t idx) const override
+    {
+        if (!vertices_.contains(idx)) {
+            return {};
         }
+        /// Undirected graph is symmetric, inbounds are the same as outbounds.
+        return (Dir ? inbounds_[idx] : outbounds_[idx]).range(true);
     }
 
-    virtual const std::set<int> &adjacent_vertices(int idx) const override {
-        return std::set<int>();
+    /**
+     * Get vertices reachable from the specified vertex by one edge.
+     *
+     * @param idx Vertex index.
+     * @param mode 1 to include filtered edges, otherwise they are skipped.
+     */
+    NeighbourRange<W> out_neighbours(vertex_index_t idx, int mode) const override
+    {
+        if (!vertices_.contains(idx)) {
+            return {};
+        }
+        return outbounds_[idx].range(mode != 1);
     }
 
-    virtual const Vertex<V> &vertex(int idx) const override {
+    const Vertex<V> &vertex(vertex_index_t idx) const override
+    {
         return vertices_.at(idx);
     }
 
-    virtual int vertex_num() const override {
-        return vertex_num_;
+    size_t vertex_num() const override { return static_cast<size_t>(vertex_num_); }
+
+    vertex_index_t vertex_bound() const override { return vertex_bound_; }
+
+    /**
+     * Add edge, edge between the same vertices is left intact.
+     *
+     * @param edge Edge to add.
+     * @throw std::out_of_range if some vertex is not presented.
+     */
+    void add_edge(Edge<E, W> edge) override
+    {
+        vertex_index_t idx1 = edge.idx1();
+        vertex_index_t idx2 = edge.idx2();
+        check_vertices(idx1, idx2);
+        normalize(&idx1, &idx2);
+        if (has_edge(idx1, idx2)) {
+            return;
+        }
+
+        size_t id = edges_.size();
+        edges_.emplace_back(idx1, idx2, edge.weight(), std::move(edge).parameters());
+        link_edge(id);
+    }
+
+    EdgeRef<E, W> edge(vertex_index_t idx1, vertex_index_t idx2) const override
+    {
+        size_t id = find_edge(idx1, idx2);
+        if (id == no_edge) {
+            throw std::out_of_range("Edge is not presented");
+        }
+        return EdgeRef<E, W>(&edges_, id);
+    }
+
+    /**
+     * Check that the edge is in the graph.
+     *
+     * @param edge Edge to check.
+     * @return True if there is such edge, filtered or not, false otherwise.
+     */
+    bool edge_exists(Edge<E, W> edge) const override
+    {
+        return has_edge(edge.idx1(), edge.idx2());
+    }
+
+    /**
+     * Remove specified edge from the graph.
+     *
+     * @param edge Edge to remove.
+     * @note Last edge in the storage takes place of the removed one.
+     */
+    void rm_edge(Edge<E, W> edge) override
+    {
+        vertex_index_t idx1 = edge.idx1();
+        vertex_index_t idx2 = edge.idx2();
+        check_vertices(idx1, idx2);
+        normalize(&idx1, &idx2);
+
+        size_t id = find_edge(idx1, idx2);
+        if (id == no_edge) {
+            return;
+        }
+
+        /// Filter stays in the filter matrix and applies if the edge is added again.
+        erase_edge(id);
+        unlink(&outbounds_, &matrix_, idx1, idx2);
+        if (Dir) {
+            unlink(&inbounds_, &in_matrix_, idx2, idx1);
+        }
+        else if (idx1 != idx2) {
+            unlink(&outbounds_, &matrix_, idx2, idx1);
+        }
+    }
+
+    size_t edge_num() const override { return edges_.size(); }
+
+    /**
+     * Temporarily remove specified edge from the graph.
+     *
+     * @param edge Edge to filter out.
+     * @return False if edge is not present in the graph, true otherwise.
+     * @note Filter is set regardless of edge presence, absent edge is added filtered.
+     */
+    bool filter_edge(Edge<E, W> edge) override
+    {
+        vertex_index_t idx1 = edge.idx1();
+        vertex_index_t idx2 = edge.idx2();
+        check_vertices(idx1, idx2);
+        normalize(&idx1, &idx2);
+
+        set_bit(&filter_matrix_, idx1, idx2);
+        size_t id = find_edge(idx1, idx2);
+        if (id == no_edge) {
+            return false;
+        }
+
+        if (!filtered_.test(id)) {
+            filtered_.set(id);
+            set_filtered(idx1, idx2, true);
+        }
+        return true;
+    }
+
+    bool filter_edges(const std::vector<Edge<E, W>> &edges) override
+    {
+        bool rc = true;
+        for (const auto &edge : edges) {
+            if (!filter_edge(edge)) {
+                rc = false;
+            }
+        }
+        return rc;
+    }
+
+    /**
+     * Restore temporarily removed edge.
+     *
+     * @param edge Edge to restore.
+     * @return True if there was such filter, false otherwise.
+     */
+    bool restore_edge(Edge<E, W> edge) override
+    {
+        vertex_index_t idx1 = edge.idx1();
+        vertex_index_t idx2 = edge.idx2();
+        check_vertices(idx1, idx2);
+        normalize(&idx1, &idx2);
+
+        if (!test_bit(filter_matrix_, idx1, idx2)) {
+            return false;
+        }
+        reset_bit(&filter_matrix_, idx1, idx2);
+
+        size_t id = find_edge(idx1, idx2);
+        if (id != no_edge) {
+            filtered_.reset(id);
+            set_filtered(idx1, idx2, false);
+        }
+        return true;
+    }
+
+    bool restore_edges(const std::vector<Edge<E, W>> &edges) override
+    {
+        bool rc = true;
+        for (const auto &edge : edges) {
+            if (!restore_edge(edge)) {
+                rc = false;
+            }
+        }
+        return rc;
+    }
+
+    void restore_edges() override
+    {
+        for (size_t id = 0; !filtered_.none() && (id < edges_.size()); ++id) {
+            if (filtered_.test(id)) {
+                filtered_.reset(id);
+                set_filtered(edges_.idx1(id), edges_.idx2(id), false);
+            }
+        }
+        std::fill(filter_matrix_.begin(), filter_matrix_.end(), 0);
+    }
+
+    /**
+     * Get all edges of the graph.
+     *
+     * @return View over edges, filtered edges are skipped.
+     */
+    EdgeRange<E, W> edges() const override
+    {
+        return EdgeRange<E, W>(&edges_, filtered_.none() ? nullptr : &filtered_);
+    }
+
+    /**
+     * Check that there is an edge between vertices.
+     *
+     * @param idx1 Source vertex index.
+     * @param idx2 Target vertex index.
+     * @return True if there is such edge, filtered or not, false otherwise.
+     */
+    bool has_edge(vertex_index_t idx1, vertex_index_t idx2) const
+    {
+        if ((idx1 < 0) || (idx1 >= capacity_) || (idx2 < 0) || (idx2 >= capacity_)) {
+            return false;
+        }
+        return test_bit(matrix_, idx1, idx2);
+    }
+
+    /**
+     * Get number of 64-bit words in a matrix row.
+     */
+    size_t row_words() const { return row_words_; }
+
+    /**
+     * Get row of the adjacency matrix.
+     *
+     * @param idx Vertex index, must be less than vertex_bound().
+     * @return Bitmap of outbound neighbours of row_words() words.
+     */
+    const std::uint64_t *row(vertex_index_t idx) const
+    {
+        return matrix_.data() + idx * row_words_;
+    }
+
+    /**
+     * Get row of the transposed adjacency matrix.
+     *
+     * @param idx Vertex index, must be less than vertex_bound().
+     * @return Bitmap of inbound neighbours of row_words() words.
+     */
+    const std::uint64_t *in_row(vertex_index_t idx) const
+    {
+        return (Dir ? in_matrix_.data() : matrix_.data()) + idx * row_words_;
+    }
+
+    /**
+     * Get number of vertices reachable by one edge from both vertices.
+     *
+     * @param idx1 First vertex index, must be less than vertex_bound().
+     * @param idx2 Second vertex index, must be less than vertex_bound().
+     * @return Number of common outbound neighbours.
+     */
+    size_t common_neighbour_num(vertex_index_t idx1, vertex_index_t idx2) const
+    {
+        return detail::row_and_count(row(idx1), row(idx2), row_words_);
+    }
+
+    /**
+     * Get vertices reachable by one edge from both vertices.
+     *
+     * @param idx1 First vertex index, must be less than vertex_bound().
+     * @param idx2 Second vertex index, must be less than vertex_bound().
+     * @return Common outbound neighbours in ascending order.
+     */
+    std::vector<vertex_index_t> common_neighbours(vertex_index_t idx1, vertex_index_t idx2) const
+    {
+        std::vector<std::uint64_t> words(row_words_);
+        detail::row_and(words.data(), row(idx1), row(idx2), row_words_);
+
+        std::vector<vertex_index_t> res;
+        for (size_t i = 0; i < row_words_; ++i) {
+            for (std::uint64_t w = words[i]; w != 0; w &= w - 1) {
+                res.push_back(static_cast<vertex_index_t>(i * 64 + detail::count_trailing_zeros(w)));
+            }
+        }
+        return res;
     }
 
-    virtual int add_edge(const Edge<E> &edge) override {
-        std::pair<int, int> minmax = std::minmax(edge.idx1(), edge.idx2());
-        if (minmax.second >= vertex_num_) {
-            return -1;
+    /**
+     * Add outbound neighbours of all frontier vertices to the bitmap.
+     *
+     * @param frontier Bitmap of row_words() words.
+     * @param next Bitmap of row_words() words, rows of frontier vertices are ORed into it.
+     */
+    void expand(const std::uint64_t *frontier, std::uint64_t *next) const
+    {
+        for (size_t i = 0; i < row_words_; ++i) {
+            for (std::uint64_t w = frontier[i]; w != 0; w &= w - 1) {
+                vertex_index_t u = static_cast<vertex_index_t>(i * 64 + detail::count_trailing_zeros(w));
+                detail::row_or(next, row(u), row_words_);
+            }
         }
-        if (!Dir) {
-//            edge.idx1() = minmax.first;
-//            edge.idx2() = minmax.second;
+    }
+
+private:
+    std::uint64_t *row_data(std::vector<std::uint64_t> *matrix, vertex_index_t idx)
+    {
+        return matrix->data() + idx * row_words_;
+    }
+
+    bool test_bit(const std::vector<std::uint64_t> &matrix, vertex_index_t idx1, vertex_index_t idx2) const
+    {
+        return (matrix[idx1 * row_words_ + idx2 / 64] >> (idx2 % 64)) & 1;
+    }
+
+    void set_bit(std::vector<std::uint64_t> *matrix, vertex_index_t idx1, vertex_index_t idx2)
+    {
+        (*matrix)[idx1 * row_words_ + idx2 / 64] |= std::uint64_t(1) << (idx2 % 64);
+    }
+
+    void reset_bit(std::vector<std::uint64_t> *matrix, vertex_index_t idx1, vertex_index_t idx2)
+    {
+        (*matrix)[idx1 * row_words_ + idx2 / 64] &= ~(std::uint64_t(1) << (idx2 % 64));
+    }
+
+    /**
+     * Get position of the neighbour in adjacency arrays, the number of its predecessors in the row.
+     */
+    size_t rank(const std::vector<std::uint64_t> &matrix, vertex_index_t idx1, vertex_index_t idx2) const
+    {
+        return detail::row_rank(matrix.data() + idx1 * row_words_, static_cast<size_t>(idx2));
+    }
+
+    void check_vertices(vertex_index_t idx1, vertex_index_t idx2) const
+    {
+        if (!vertices_.contains(idx1) || !vertices_.contains(idx2)) {
+            throw std::out_of_range("Vertex index is not presented");
         }
-        matrix_[edge.idx1() * vertex_num_ + edge.idx2()] = true;
-        return 0;
     }
 
-    virtual int rm_edge(const Edge<E> &edge) override {
-        std::pair<int, int> minmax = std::minmax(edge.idx1(), edge.idx2());
-        if (minmax.second >= vertex_num_) {
-            return -1;
+    /**
+     * Order endpoints of undirected edge as min_idx->max_idx, same as in ListGraph.
+     */
+    static void normalize(vertex_index_t *idx1, vertex_index_t *idx2)
+    {
+        if (!Dir && (*idx1 > *idx2)) {
+            std::swap(*idx1, *idx2);
         }
-        if (!Dir) {
-//            edge.idx1() = minmax.first;
-//            edge.idx2() = minmax.second;
+    }
+
+    /**
+     * Find position of the edge in the storage.
+     *
+     * @return Edge position or no_edge if there is no such edge.
+     */
+    size_t find_edge(vertex_index_t idx1, vertex_index_t idx2) const
+    {
+        if (!has_edge(idx1, idx2)) {
+            return no_edge;
         }
-        matrix_[edge.idx1() * vertex_num_ + edge.idx2()] = false;
-        return 0;
+        return outbounds_[idx1].edge[rank(matrix_, idx1, idx2)];
+    }
+
+    /**
+     * Add edge appended to the storage to adjacency arrays and the matrix.
+     *
+     * @param id Edge position.
+     */
+    void link_edge(size_t id)
+    {
+        vertex_index_t idx1 = edges_.idx1(id);
+        vertex_index_t idx2 = edges_.idx2(id);
+        W weight = edges_.weight(id);
+
+        /// Edge could be filtered out before it was added.
+        bool is_filtered = test_bit(filter_matrix_, idx1, idx2);
+
+        link(&outbounds_, &matrix_, idx1, idx2, weight, is_filtered, id);
+        if (Dir) {
+            link(&inbounds_, &in_matrix_, idx2, idx1, weight, is_filtered, no_edge);
+        }
+        else if (idx1 != idx2) {
+            link(&outbounds_, &matrix_, idx2, idx1, weight, is_filtered, id);
+        }
+
+        filtered_.resize(id + 1);
+        filtered_.assign(id, is_filtered);
+    }
+
+    void link(std::vector<Adjacency> *adjacency, std::vector<std::uint64_t> *matrix, vertex_index_t idx1,
+            vertex_index_t idx2, W weight, bool is_filtered, size_t id)
+    {
+        Adjacency &a = (*adjacency)[idx1];
+        size_t pos = rank(*matrix, idx1, idx2);
+        a.insert(pos, idx2, weight, is_filtered);
+        if (id != no_edge) {
+            a.edge.insert(a.edge.begin() + pos, id);
+        }
+        set_bit(matrix, idx1, idx2);
+    }
+
+    void unlink(std::vector<Adjacency> *adjacency, std::vector<std::uint64_t> *matrix, vertex_index_t idx1,
+            vertex_index_t idx2)
+    {
+        (*adjacency)[idx1].erase(rank(*matrix, idx1, idx2));
+        reset_bit(matrix, idx1, idx2);
+    }
+
+    /**
+     * Remove edge from the storage, adjacency arrays and the matrix are left intact.
+     *
+     * @param id Edge position, last edge in the storage takes its place.
+     */
+    void erase_edge(size_t id)
+    {
+        size_t last = edges_.size() - 1;
+        if (id != last) {
+            edges_.move(last, id);
+            filtered_.assign(id, filtered_.test(last));
+
+            vertex_index_t idx1 = edges_.idx1(id);
+            vertex_index_t idx2 = edges_.idx2(id);
+            outbounds_[idx1].edge[rank(matrix_, idx1, idx2)] = id;
+            if (!Dir && (idx1 != idx2)) {
+                outbounds_[idx2].edge[rank(matrix_, idx2, idx1)] = id;
+            }
+        }
+        edges_.pop_back();
+        filtered_.resize(last);
+    }
+
+    /**
+     * Update filter flags of the edge in adjacency arrays.
+     */
+    void set_filtered(vertex_index_t idx1, vertex_index_t idx2, bool is_filtered)
+    {
+        outbounds_[idx1].set_filtered(rank(matrix_, idx1, idx2), is_filtered);
+        if (Dir) {
+            inbounds_[idx2].set_filtered(rank(in_matrix_, idx2, idx1), is_filtered);
+        }
+        else if (idx1 != idx2) {
+            outbounds_[idx2].set_filtered(rank(matrix_, idx2, idx1), is_filtered);
+        }
+    }
+
+    /**
+     * Grow matrices to fit vertex indices up to the bound, capacity is at least doubled on growth.
+     *
+     * @param bound Upper bound of vertex indices.
+     */
+    void reserve(vertex_index_t bound)
+    {
+        if (bound <= capacity_) {
+            return;
+        }
+
+        vertex_index_t capacity = std::max(bound, 2 * capacity_);
+        size_t row_words = (static_cast<size_t>(capacity) + 63) / 64;
+        capacity = static_cast<vertex_index_t>(row_words * 64);
+
+        grow(&matrix_, capacity, row_words);
+        if (Dir) {
+            grow(&in_matrix_, capacity, row_words);
+            inbounds_.resize(capacity);
+        }
+        grow(&filter_matrix_, capacity, row_words);
+        outbounds_.resize(capacity);
+
+        capacity_ = capacity;
+        row_words_ = row_words;
+    }
+
+    void grow(std::vector<std::uint64_t> *matrix, vertex_index_t capacity, size_t row_words) const
+    {
+        std::vector<std::uint64_t> res(static_cast<size_t>(capacity) * row_words, 0);
+        for (vertex_index_t idx = 0; idx < capacity_; ++idx) {
+            std::copy(matrix->data() + idx * row_words_, matrix->data() + (idx + 1) * row_words_,
+                    res.data() + idx * row_words);
+        }
+        matrix->swap(res);
     }
 
 private:
-    int vertex_num_;
-    std::map<int, Vertex<V>> vertices_;
-    std::vector<bool> matrix_;
+    vertex_index_t vertex_num_;
+    vertex_index_t vertex_bound_;
+    DenseVertexMap<Vertex<V>> vertices_;
+    /// Adjacency arrays indexed by vertex, inbound ones are kept for directed graphs only.
+    std::vector<Adjacency> outbounds_;
+    std::vector<Adjacency> inbounds_;
+    /// Bit matrices of capacity_ rows, transposed one is kept for directed graphs only.
+    std::vector<std::uint64_t> matrix_;
+    std::vector<std::uint64_t> in_matrix_;
+    /// Filters of edges, present in the graph or not, undirected edges are marked as min_idx->max_idx.
+    std::vector<std::uint64_t> filter_matrix_;
+    EdgeStore<E, W> edges_;
+    Bitmap filtered_;
+    /// Number of rows and columns of the matrices.
+    vertex_index_t capacity_;
+    size_t row_words_;
 };
+
+}  // namespace simple_graph
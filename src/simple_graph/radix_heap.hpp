@@ -0,0 +1,172 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "graph.hpp"
+
+namespace simple_graph {
+
+namespace detail {
+
+/**
+ * Get number of bits needed to represent the value.
+ *
+ * @param x Value.
+ * @return Position of the highest set bit plus one, 0 for 0.
+ */
+inline size_t bit_width(std::uint64_t x)
+{
+#if defined(__GNUC__)
+    return x == 0 ? 0 : 64 - __builtin_clzll(x);
+#else
+    size_t width = 0;
+    for (; x != 0; x >>= 1) {
+        ++width;
+    }
+    return width;
+#endif
+}
+
+}  // namespace detail
+
+/**
+ * Monotone priority queue of vertex indices with integer keys.
+ *
+ * Entries are distributed into buckets by the highest bit in which their key differs from the last popped
+ * key, so every entry is moved between buckets at most once per key bit. Keys must be non-negative and
+ * no key may be pushed after a greater key has been popped, which holds for Dijkstra algorithm with
+ * non-negative weights.
+ *
+ * The queue has no decrease-key operation, vertex is pushed again with the new key instead and outdated
+ * entries are expected to be skipped by the caller.
+ *
+ * @tparam K Typename for keys, must be integral.
+ */
+template<typename K>
+class RadixHeap {
+    static_assert(std::is_integral<K>::value, "Integer number required for radix heap key typename.");
+
+    using Key = typename std::make_unsigned<K>::type;
+    static constexpr size_t bucket_num = std::numeric_limits<Key>::digits + 1;
+
+public:
+    /**
+     * Constructor.
+     *
+     * @param capacity Upper bound of vertex indices, unused but kept for compatibility with IndexedHeap.
+     */
+    explicit RadixHeap(size_t capacity = 0) : buckets_(), last_(0), size_(0)
+    {
+        (void) capacity;
+    }
+
+    bool empty() const { return size_ == 0; }
+    size_t size() const { return size_; }
+
+    /**
+     * Reserve memory, there is nothing to reserve as the queue doesn't track vertex positions.
+     */
+    void reserve(size_t) {}
+
+    /**
+     * Remove all vertices from the queue.
+     */
+    void clear()
+    {
+        for (auto &bucket : buckets_) {
+            bucket.clear();
+        }
+        last_ = 0;
+        size_ = 0;
+    }
+
+    /**
+     * Add vertex to the queue.
+     *
+     * @param idx Vertex index.
+     * @param key Vertex key, must not be less than the last popped key.
+     */
+    void push(vertex_index_t idx, K key)
+    {
+        assert(key >= 0);
+        assert(static_cast<Key>(key) >= last_);
+        buckets_[bucket(static_cast<Key>(key))].emplace_back(static_cast<Key>(key), idx);
+        ++size_;
+    }
+
+    /**
+     * Add vertex to the queue or lower its key.
+     *
+     * @param idx Vertex index.
+     * @param key New vertex key.
+     * @note Previous entry of the vertex remains in the queue.
+     */
+    void update(vertex_index_t idx, K key)
+    {
+        push(idx, key);
+    }
+
+    /**
+     * Remove vertex with the minimal key.
+     *
+     * @return Removed vertex index.
+     */
+    vertex_index_t pop()
+    {
+        assert(!empty());
+
+        if (buckets_[0].empty()) {
+            size_t i = 1;
+            while (buckets_[i].empty()) {
+                ++i;
+            }
+
+            /// Minimal key of the first non-empty bucket becomes the new base, redistribute bucket by it.
+            Key min = buckets_[i].front().first;
+            for (const auto &entry : buckets_[i]) {
+                min = std::min(min, entry.first);
+            }
+            last_ = min;
+
+            for (const auto &entry : buckets_[i]) {
+                buckets_[bucket(entry.first)].push_back(entry);
+            }
+            buckets_[i].clear();
+        }
+
+        vertex_index_t idx = buckets_[0].back().second;
+        buckets_[0].pop_back();
+        --size_;
+
+        return idx;
+    }
+
+    /**
+     * Get key of the last popped vertex.
+     *
+     * @return Key.
+     */
+    K last() const
+    {
+        return static_cast<K>(last_);
+    }
+
+private:
+    size_t bucket(Key key) const
+    {
+        return detail::bit_width(static_cast<std::uint64_t>(key ^ last_));
+    }
+
+private:
+    std::array<std::vector<std::pair<Key, vertex_index_t>>, bucket_num> buckets_;
+    Key last_;
+    size_t size_;
+};
+
+}  // namespace simple_graph
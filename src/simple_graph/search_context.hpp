@@ -0,0 +1,176 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+#include "graph.hpp"
+
+namespace simple_graph {
+
+/**
+ * Reusable state of graph searches.
+ *
+ * Context owns per-vertex buffers (visited flag, distance, predecessor) and the frontier container, so that
+ * consecutive queries don't allocate them again. Instead of clearing all entries before every query each
+ * entry is stamped with the query generation, entry with outdated stamp reads as untouched. Cost of a query
+ * is therefore proportional to the number of vertices it touches, not to the size of the graph.
+ *
+ * Context must not be shared between concurrently running queries.
+ *
+ * @tparam D Typename for distances.
+ * @tparam Queue Typename for frontier container, must provide clear().
+ */
+template<typename D, typename Queue>
+class SearchContext {
+public:
+    SearchContext() : entries_(), generation_(0), queue_(0) {}
+
+    /**
+     * Start new query.
+     *
+     * @param vertex_num Upper bound of vertex indices used in the query.
+     */
+    void reset(size_t vertex_num)
+    {
+        if (entries_.size() < vertex_num) {
+            entries_.resize(vertex_num);
+        }
+
+        /// Stamps are about to repeat, forget all of them.
+        if (generation_ == std::numeric_limits<std::uint32_t>::max()) {
+            for (auto &entry : entries_) {
+                entry.generation = 0;
+            }
+            generation_ = 0;
+        }
+        ++generation_;
+
+        queue_.clear();
+    }
+
+    bool visited(vertex_index_t idx) const
+    {
+        const Entry &entry = entries_[idx];
+        return (entry.generation == generation_) && entry.visited;
+    }
+
+    void visit(vertex_index_t idx)
+    {
+        touch(idx).visited = true;
+    }
+
+    /**
+     * Get distance to the vertex.
+     *
+     * @param idx Vertex index.
+     * @return Distance or max value of D if vertex wasn't reached.
+     */
+    D distance(vertex_index_t idx) const
+    {
+        const Entry &entry = entries_[idx];
+        return (entry.generation == generation_) ? entry.distance : std::numeric_limits<D>::max();
+    }
+
+    void set_distance(vertex_index_t idx, D distance)
+    {
+        touch(idx).distance = distance;
+    }
+
+    /**
+     * Get predecessor of the vertex.
+     *
+     * @param idx Vertex index.
+     * @return Predecessor index or -1 if there is no predecessor.
+     */
+    vertex_index_t predecessor(vertex_index_t idx) const
+    {
+        const Entry &entry = entries_[idx];
+        return (entry.generation == generation_) ? entry.predecessor : -1;
+    }
+
+    void set_predecessor(vertex_index_t idx, vertex_index_t predecessor)
+    {
+        touch(idx).predecessor = predecessor;
+    }
+
+    Queue &queue() { return queue_; }
+
+private:
+    struct Entry {
+        std::uint32_t generation = 0;
+        bool visited = false;
+        D distance = std::numeric_limits<D>::max();
+        vertex_index_t predecessor = -1;
+    };
+
+    Entry &touch(vertex_index_t idx)
+    {
+        Entry &entry = entries_[idx];
+        if (entry.generation != generation_) {
+            entry.generation = generation_;
+            entry.visited = false;
+            entry.distance = std::numeric_limits<D>::max();
+            entry.predecessor = -1;
+        }
+        return entry;
+    }
+
+private:
+    std::vector<Entry> entries_;
+    std::uint32_t generation_;
+    Queue queue_;
+};
+
+/**
+ * Context of BFS and DFS, frontier is a plain array used as a queue or as a stack.
+ */
+using TraversalContext = SearchContext<size_t, std::vector<vertex_index_t>>;
+
+/**
+ * Context of BFS over bit rows of adjacency matrix.
+ *
+ * Visited set and frontiers of all levels of a query are bitmaps of the same width. Frontiers are kept one after
+ * another, so the path is restored level by level without per-vertex distances. Buffers keep their memory
+ * between queries.
+ */
+class BitTraversalContext {
+public:
+    BitTraversalContext() : words_(0), visited_(), levels_() {}
+
+    /**
+     * Start new query.
+     *
+     * @param words Number of 64-bit words in a bitmap, must be positive.
+     */
+    void reset(size_t words)
+    {
+        words_ = words;
+        visited_.assign(words, 0);
+        levels_.clear();
+    }
+
+    std::uint64_t *visited() { return visited_.data(); }
+
+    size_t level_num() const { return levels_.size() / words_; }
+
+    /**
+     * Append empty frontier of the next level, pointers to other frontiers are invalidated.
+     *
+     * @return Frontier of the new level.
+     */
+    std::uint64_t *add_level()
+    {
+        levels_.resize(levels_.size() + words_, 0);
+        return level(level_num() - 1);
+    }
+
+    std::uint64_t *level(size_t l) { return levels_.data() + l * words_; }
+    const std::uint64_t *level(size_t l) const { return levels_.data() + l * words_; }
+
+private:
+    size_t words_;
+    std::vector<std::uint64_t> visited_;
+    std::vector<std::uint64_t> levels_;
+};
+
+}  // namespace simple_graph
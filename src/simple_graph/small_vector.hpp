@@ -0,0 +1,251 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+
+namespace simple_graph {
+
+/**
+ * Array with inline storage for a few elements.
+ *
+ * Up to N elements are stored inside the object itself, larger arrays spill to a heap block. Most vertices
+ * of sparse graphs have only a few neighbours, so their adjacency doesn't need a separate allocation and
+ * lies next to the other per-vertex data.
+ *
+ * Elements are moved with memcpy, so only trivially copyable types are supported.
+ *
+ * Heap blocks are obtained from the allocator. Allocator is never propagated on assignment, elements are
+ * copied into the storage of the assigned array instead when allocators differ.
+ *
+ * @tparam T Typename for elements, must be trivially copyable.
+ * @tparam N Number of elements stored inline.
+ * @tparam Alloc Typename for allocator of heap blocks.
+ */
+template<typename T, size_t N, typename Alloc = std::allocator<T>>
+class SmallVector : private Alloc {
+    static_assert(std::is_trivially_copyable<T>::value, "Trivially copyable typename required for small vector.");
+    static_assert(N > 0, "Inline capacity must be positive.");
+
+    using Traits = std::allocator_traits<Alloc>;
+
+public:
+    using value_type = T;
+    using allocator_type = Alloc;
+    using iterator = T*;
+    using const_iterator = const T*;
+
+    SmallVector() : Alloc(), size_(0), capacity_(N) {}
+
+    explicit SmallVector(const Alloc &alloc) : Alloc(alloc), size_(0), capacity_(N) {}
+
+    SmallVector(const SmallVector &v) : SmallVector(v, Traits::select_on_container_copy_construction(v.get_allocator())) {}
+
+    SmallVector(const SmallVector &v, const Alloc &alloc) : Alloc(alloc), size_(0), capacity_(N)
+    {
+        reserve(v.size_);
+        std::memcpy(data(), v.data(), v.size_ * sizeof(T));
+        size_ = v.size_;
+    }
+
+    SmallVector(SmallVector &&v) noexcept : Alloc(v.get_allocator()), size_(0), capacity_(N)
+    {
+        steal(v);
+    }
+
+    SmallVector(SmallVector &&v, const Alloc &alloc) : Alloc(alloc), size_(0), capacity_(N)
+    {
+        if (get_allocator() == v.get_allocator()) {
+            steal(v);
+        }
+        else {
+            *this = v;
+        }
+    }
+
+    SmallVector &operator=(const SmallVector &v)
+    {
+        if (this != &v) {
+            size_ = 0;
+            reserve(v.size_);
+            std::memcpy(data(), v.data(), v.size_ * sizeof(T));
+            size_ = v.size_;
+        }
+        return *this;
+    }
+
+    SmallVector &operator=(SmallVector &&v)
+    {
+        if (this == &v) {
+            return *this;
+        }
+        if (get_allocator() == v.get_allocator()) {
+            release();
+            steal(v);
+        }
+        else {
+            *this = v;
+        }
+        return *this;
+    }
+
+    ~SmallVector()
+    {
+        release();
+    }
+
+    Alloc get_allocator() const { return *this; }
+
+    size_t size() const { return size_; }
+    size_t capacity() const { return capacity_; }
+    bool empty() const { return size_ == 0; }
+
+    /**
+     * Check that elements are stored inside the object.
+     */
+    bool is_inline() const { return capacity_ == N; }
+
+    T *data() { return is_inline() ? storage_.inline_data : storage_.heap_data; }
+    const T *data() const { return is_inline() ? storage_.inline_data : storage_.heap_data; }
+
+    iterator begin() { return data(); }
+    iterator end() { return data() + size_; }
+    const_iterator begin() const { return data(); }
+    const_iterator end() const { return data() + size_; }
+
+    T &operator[](size_t pos) { return data()[pos]; }
+    const T &operator[](size_t pos) const { return data()[pos]; }
+
+    /**
+     * Make room for elements, capacity grows at least twice to keep insertion amortized O(1).
+     *
+     * @param capacity Required number of elements.
+     */
+    void reserve(size_t capacity)
+    {
+        if (capacity <= capacity_) {
+            return;
+        }
+        capacity = std::max<size_t>(capacity, 2 * capacity_);
+
+        T *heap_data = Traits::allocate(allocator(), capacity);
+        std::memcpy(heap_data, data(), size_ * sizeof(T));
+        release();
+        storage_.heap_data = heap_data;
+        capacity_ = static_cast<std::uint32_t>(capacity);
+    }
+
+    void push_back(const T &value)
+    {
+        reserve(size_ + 1);
+        data()[size_++] = value;
+    }
+
+    /**
+     * Insert element before the position.
+     *
+     * @param pos Position in the array.
+     * @param value Element to insert.
+     * @return Iterator to the inserted element.
+     */
+    iterator insert(const_iterator pos, const T &value)
+    {
+        size_t offset = pos - begin();
+        assert(offset <= size_);
+        reserve(size_ + 1);
+        T *p = data() + offset;
+        std::memmove(p + 1, p, (size_ - offset) * sizeof(T));
+        *p = value;
+        ++size_;
+        return p;
+    }
+
+    /**
+     * Remove element at the position.
+     *
+     * @param pos Position in the array.
+     * @return Iterator to the element following the removed one.
+     */
+    iterator erase(const_iterator pos)
+    {
+        size_t offset = pos - begin();
+        assert(offset < size_);
+        T *p = data() + offset;
+        std::memmove(p, p + 1, (size_ - offset - 1) * sizeof(T));
+        --size_;
+        return p;
+    }
+
+    /**
+     * Change number of elements, new elements are value-initialized.
+     *
+     * @param size New number of elements.
+     */
+    void resize(size_t size)
+    {
+        reserve(size);
+        if (size > size_) {
+            std::fill(data() + size_, data() + size, T());
+        }
+        size_ = static_cast<std::uint32_t>(size);
+    }
+
+    void clear() { size_ = 0; }
+
+    /**
+     * Free heap block if elements fit inline storage.
+     */
+    void shrink_to_fit()
+    {
+        if (is_inline() || (size_ > N)) {
+            return;
+        }
+        T *heap_data = storage_.heap_data;
+        std::memcpy(storage_.inline_data, heap_data, size_ * sizeof(T));
+        Traits::deallocate(allocator(), heap_data, capacity_);
+        capacity_ = N;
+    }
+
+private:
+    Alloc &allocator() { return *this; }
+
+    void release()
+    {
+        if (!is_inline()) {
+            Traits::deallocate(allocator(), storage_.heap_data, capacity_);
+            capacity_ = N;
+        }
+    }
+
+    /**
+     * Take elements of the other array leaving it empty, this array must not own a heap block and allocators
+     * must be equal.
+     */
+    void steal(SmallVector &v)
+    {
+        if (v.is_inline()) {
+            std::memcpy(storage_.inline_data, v.storage_.inline_data, v.size_ * sizeof(T));
+        }
+        else {
+            storage_.heap_data = v.storage_.heap_data;
+            capacity_ = v.capacity_;
+            v.capacity_ = N;
+        }
+        size_ = v.size_;
+        v.size_ = 0;
+    }
+
+private:
+    std::uint32_t size_;
+    std::uint32_t capacity_;
+    union Storage {
+        T inline_data[N];
+        T *heap_data;
+    } storage_;
+};
+
+}  // namespace simple_graph
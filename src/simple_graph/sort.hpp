@@ -0,0 +1,99 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <vector>
+#include "simple_graph/thread_pool.hpp"
+
+namespace simple_graph {
+
+namespace detail {
+
+/**
+ * Sort range using several threads.
+ *
+ * Range is split into chunks which are sorted concurrently, then neighbouring chunks are merged pairwise,
+ * merges of one round run concurrently too. Chunks are run on the shared thread pool. Small ranges are sorted
+ * in the calling thread.
+ *
+ * @param first Random access iterator to the first element.
+ * @param last Random access iterator past the last element.
+ * @param comp Comparator, called concurrently from several threads.
+ * @param threads Maximal number of chunks, fewer chunks are used if they get too small.
+ * @note Sort is not stable.
+ */
+template<typename It, typename Compare>
+void parallel_sort(It first, It last, Compare comp, size_t threads = ThreadPool::shared().size())
+{
+    /// Minimal number of elements per chunk, smaller chunks aren't worth a separate task.
+    constexpr size_t min_chunk = size_t(1) << 14;
+
+    size_t size = static_cast<size_t>(std::distance(first, last));
+    threads = std::min(threads, size / min_chunk);
+    if (threads <= 1) {
+        std::sort(first, last, comp);
+        return;
+    }
+
+    std::vector<It> bounds;
+    for (size_t i = 0; i <= threads; ++i) {
+        bounds.push_back(first + static_cast<std::ptrdiff_t>(size * i / threads));
+    }
+
+    ThreadPool &pool = ThreadPool::shared();
+    pool.parallel_for(0, threads, [&bounds, &comp](size_t, size_t i) {
+        std::sort(bounds[i], bounds[i + 1], comp);
+    }, 1);
+
+    /// Every round halves number of sorted chunks.
+    while (bounds.size() > 2) {
+        size_t merges = (bounds.size() - 1) / 2;
+        pool.parallel_for(0, merges, [&bounds, &comp](size_t, size_t i) {
+            std::inplace_merge(bounds[2 * i], bounds[2 * i + 1], bounds[2 * i + 2], comp);
+        }, 1);
+
+        std::vector<It> merged;
+        for (size_t i = 0; i < merges; ++i) {
+            merged.push_back(bounds[2 * i]);
+        }
+        if (bounds.size() % 2 == 0) {
+            /// Odd number of chunks, the last one waits for the next round.
+            merged.push_back(bounds[bounds.size() - 2]);
+        }
+        merged.push_back(bounds.back());
+        bounds.swap(merged);
+    }
+}
+
+/**
+ * Stable sort by integer key.
+ *
+ * Counting sort takes linear time, but it needs an array of counters for all keys, so it fits keys with
+ * small upper bound.
+ *
+ * @param in Elements to sort.
+ * @param out Sorted elements.
+ * @param bound Upper bound of keys.
+ * @param key Function returning key of element, key must be in range [0, bound).
+ */
+template<typename T, typename Key>
+void counting_sort(const std::vector<T> &in, std::vector<T> *out, size_t bound, Key key)
+{
+    std::vector<size_t> offsets(bound + 1, 0);
+    for (const auto &v : in) {
+        ++offsets[static_cast<size_t>(key(v)) + 1];
+    }
+    for (size_t i = 1; i <= bound; ++i) {
+        offsets[i] += offsets[i - 1];
+    }
+
+    out->resize(in.size());
+    for (const auto &v : in) {
+        (*out)[offsets[static_cast<size_t>(key(v))]++] = v;
+    }
+}
+
+}  // namespace detail
+
+}  // namespace simple_graph
@@ -0,0 +1,479 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace simple_graph {
+
+namespace detail {
+
+/**
+ * Range of loop indices waiting in a deque.
+ */
+struct LoopTask {
+    /// Job the range belongs to.
+    void *job;
+    size_t begin;
+    size_t end;
+};
+
+/**
+ * Chase-Lev work-stealing deque of fixed capacity.
+ *
+ * The owner thread pushes and pops tasks at the bottom, other threads steal them from the top. Every slot
+ * carries a tag next to the task, so a thief can check whom the top task belongs to without touching the
+ * task itself, which may already be gone.
+ */
+class TaskDeque {
+public:
+    static constexpr std::int64_t capacity = 256;
+
+    TaskDeque() : top_(0), bottom_(0)
+    {
+        for (auto &slot : slots_) {
+            slot.task.store(nullptr, std::memory_order_relaxed);
+            slot.tag.store(nullptr, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * Get bottom position, tasks pushed later are placed above it.
+     */
+    std::int64_t bottom() const { return bottom_.load(std::memory_order_relaxed); }
+
+    /**
+     * Check if tasks pushed above the position are still in the deque, called by the owner only.
+     *
+     * @param base Bottom position taken before the tasks were pushed.
+     */
+    bool has_above(std::int64_t base) const
+    {
+        std::int64_t b = bottom_.load(std::memory_order_relaxed);
+        std::int64_t t = top_.load(std::memory_order_acquire);
+        return b > std::max(t, base);
+    }
+
+    bool empty() const
+    {
+        return top_.load(std::memory_order_seq_cst) >= bottom_.load(std::memory_order_seq_cst);
+    }
+
+    /**
+     * Push task, called by the owner only.
+     *
+     * @return False if the deque is full.
+     */
+    bool push(LoopTask *task, const void *tag)
+    {
+        std::int64_t b = bottom_.load(std::memory_order_relaxed);
+        std::int64_t t = top_.load(std::memory_order_acquire);
+        if (b - t >= capacity) {
+            return false;
+        }
+        Slot &slot = slots_[b % capacity];
+        slot.task.store(task, std::memory_order_relaxed);
+        slot.tag.store(tag, std::memory_order_relaxed);
+        /// Sequentially consistent store publishes the task and is ordered before a check for sleepers.
+        bottom_.store(b + 1, std::memory_order_seq_cst);
+        return true;
+    }
+
+    /**
+     * Pop the latest task, called by the owner only.
+     *
+     * @return Task or nullptr if the deque is empty.
+     */
+    LoopTask *pop()
+    {
+        std::int64_t b = bottom_.load(std::memory_order_relaxed) - 1;
+        /// Taking the task must be ordered before reading the top, as in a concurrent steal.
+        bottom_.store(b, std::memory_order_seq_cst);
+        std::int64_t t = top_.load(std::memory_order_seq_cst);
+
+        LoopTask *task = nullptr;
+        if (t <= b) {
+            task = slots_[b % capacity].task.load(std::memory_order_relaxed);
+            if (t == b) {
+                /// The last task, race against thieves for it.
+                if (!top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                        std::memory_order_relaxed)) {
+                    task = nullptr;
+                }
+                bottom_.store(b + 1, std::memory_order_relaxed);
+            }
+        }
+        else {
+            bottom_.store(b + 1, std::memory_order_relaxed);
+        }
+        return task;
+    }
+
+    /**
+     * Steal the oldest task if its tag matches.
+     *
+     * @param tag Required tag, nullptr to steal any task.
+     * @return Task or nullptr if the deque is empty, the tag doesn't match or another thread won the race.
+     */
+    LoopTask *steal(const void *tag)
+    {
+        std::int64_t t = top_.load(std::memory_order_seq_cst);
+        std::int64_t b = bottom_.load(std::memory_order_seq_cst);
+        if (t >= b) {
+            return nullptr;
+        }
+
+        /// Slot can't be reused by the owner while the top still points to it.
+        const Slot &slot = slots_[t % capacity];
+        if (tag && (slot.tag.load(std::memory_order_relaxed) != tag)) {
+            return nullptr;
+        }
+        LoopTask *task = slot.task.load(std::memory_order_relaxed);
+        if (!top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+            return nullptr;
+        }
+        return task;
+    }
+
+private:
+    struct Slot {
+        std::atomic<LoopTask *> task;
+        std::atomic<const void *> tag;
+    };
+
+    alignas(64) std::atomic<std::int64_t> top_;
+    alignas(64) std::atomic<std::int64_t> bottom_;
+    Slot slots_[capacity];
+};
+
+}  // namespace detail
+
+/**
+ * Work-stealing scheduler of parallel loops.
+ *
+ * Every worker owns a Chase-Lev deque. A worker running a loop range splits off the upper half of the range
+ * into its deque whenever the deque has nothing of the range pending, idle workers steal the oldest, i.e. the
+ * largest, ranges. A busy pool thus runs ranges in big sequential chunks, while an idle pool splits them down
+ * to the grain to keep all workers fed.
+ *
+ * The thread calling parallel_for() takes part in the loop: pool threads are workers 1 to size() - 1, worker 0
+ * is taken by one outside caller at a time, other outside callers wait. Loop body may start nested loops on
+ * the same pool, the worker then helps with the nested loop until it's done.
+ */
+class ThreadPool {
+public:
+    /**
+     * Constructor.
+     *
+     * @param threads Number of workers including the calling thread, hardware concurrency by default.
+     */
+    explicit ThreadPool(size_t threads = std::thread::hardware_concurrency())
+        : sleepers_(0), epoch_(0), stop_(false)
+    {
+        threads = std::max<size_t>(threads, 1);
+        for (size_t worker = 0; worker < threads; ++worker) {
+            workers_.push_back(std::make_unique<detail::TaskDeque>());
+        }
+        for (size_t worker = 1; worker < threads; ++worker) {
+            threads_.emplace_back([this, worker] { work(worker); });
+        }
+    }
+
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    ~ThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        wake_.notify_all();
+        for (auto &t : threads_) {
+            t.join();
+        }
+    }
+
+    /**
+     * Get pool shared by parallel algorithms of the library, it has a worker per hardware thread.
+     */
+    static ThreadPool &shared()
+    {
+        static ThreadPool pool;
+        return pool;
+    }
+
+    /**
+     * Get number of workers including the calling thread.
+     */
+    size_t size() const { return workers_.size(); }
+
+    /**
+     * Call function for every index of the range and wait for all calls to finish.
+     *
+     * @param begin First index.
+     * @param end Index past the last one.
+     * @param f Callable with signature void(size_t worker, size_t idx), worker is below size() and no two
+     *        concurrent calls of the loop get the same worker.
+     * @param grain Number of indices not worth splitting further, 0 to pick it from the range size.
+     * @throw Rethrows the first exception thrown by f, calls not started by then are skipped.
+     */
+    template<typename F>
+    void parallel_for(size_t begin, size_t end, const F &f, size_t grain = 0)
+    {
+        if (begin >= end) {
+            return;
+        }
+        if (grain == 0) {
+            /// Several chunks per worker, lazy splitting takes care of the balance within that.
+            grain = std::max<size_t>((end - begin) / (8 * size()), 1);
+        }
+
+        Current &current = current_worker();
+        if (current.pool == this) {
+            run_loop(current.worker, begin, end, f, grain);
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock(outside_mutex_);
+        Current saved = current;
+        current = {this, 0};
+        try {
+            run_loop(0, begin, end, f, grain);
+        }
+        catch (...) {
+            current = saved;
+            throw;
+        }
+        current = saved;
+    }
+
+private:
+    struct Current {
+        ThreadPool *pool;
+        size_t worker;
+    };
+
+    /**
+     * State of a running loop, lives on the stack of the thread which started the loop.
+     */
+    struct Job {
+        void (*call)(const void *, size_t, size_t, size_t);
+        const void *f;
+        size_t grain;
+        /// Number of indices not yet run, the loop is over at zero.
+        std::atomic<size_t> remaining;
+        std::atomic<bool> failed;
+        std::exception_ptr error;
+        /// Storage of split off ranges, a range is split off at most once per grain of indices.
+        std::unique_ptr<detail::LoopTask[]> tasks;
+        size_t task_capacity;
+        std::atomic<size_t> task_num;
+    };
+
+    static Current &current_worker()
+    {
+        static thread_local Current current = {nullptr, 0};
+        return current;
+    }
+
+    template<typename F>
+    void run_loop(size_t worker, size_t begin, size_t end, const F &f, size_t grain)
+    {
+        Job job;
+        job.call = [](const void *fn, size_t w, size_t first, size_t last) {
+            const F &body = *static_cast<const F *>(fn);
+            for (size_t idx = first; idx < last; ++idx) {
+                body(w, idx);
+            }
+        };
+        job.f = &f;
+        job.grain = grain;
+        job.remaining.store(end - begin, std::memory_order_relaxed);
+        job.failed.store(false, std::memory_order_relaxed);
+        job.task_capacity = (size() > 1) && (end - begin > grain) ? 4 * ((end - begin) / grain + 1) : 0;
+        if (job.task_capacity) {
+            job.tasks.reset(new detail::LoopTask[job.task_capacity]);
+        }
+        job.task_num.store(0, std::memory_order_relaxed);
+
+        run_range(worker, &job, begin, end);
+
+        /// Help with ranges of the loop stolen by other workers, other loops are left to idle workers.
+        while (job.remaining.load(std::memory_order_acquire) != 0) {
+            if (!steal_and_run(worker, &job)) {
+                std::this_thread::yield();
+            }
+        }
+
+        if (job.failed.load(std::memory_order_relaxed)) {
+            std::rethrow_exception(job.error);
+        }
+    }
+
+    /**
+     * Run range of the loop together with ranges split off from it and not stolen.
+     */
+    void run_range(size_t worker, Job *job, size_t begin, size_t end)
+    {
+        detail::TaskDeque &deque = *workers_[worker];
+        std::int64_t base = deque.bottom();
+        size_t done = 0;
+
+        for (;;) {
+            while (begin < end) {
+                if ((end - begin > job->grain) && !deque.has_above(base) && split(worker, job, begin, &end)) {
+                    continue;
+                }
+
+                size_t last = std::min(end, begin + job->grain);
+                if (!job->failed.load(std::memory_order_relaxed)) {
+                    try {
+                        job->call(job->f, worker, begin, last);
+                    }
+                    catch (...) {
+                        if (!job->failed.exchange(true)) {
+                            job->error = std::current_exception();
+                        }
+                    }
+                }
+                done += last - begin;
+                begin = last;
+            }
+
+            /// Take back the split off ranges nobody has stolen.
+            if (!deque.has_above(base)) {
+                break;
+            }
+            detail::LoopTask *task = deque.pop();
+            if (!task) {
+                break;
+            }
+            begin = task->begin;
+            end = task->end;
+        }
+
+        /// The loop may be over after this, so the job must not be touched afterwards.
+        job->remaining.fetch_sub(done, std::memory_order_acq_rel);
+    }
+
+    /**
+     * Push upper half of the range to the worker deque.
+     *
+     * @return True if the half was pushed and the range end was moved to the middle.
+     */
+    bool split(size_t worker, Job *job, size_t begin, size_t *end)
+    {
+        size_t idx = job->task_num.fetch_add(1, std::memory_order_relaxed);
+        if (idx >= job->task_capacity) {
+            return false;
+        }
+
+        size_t middle = begin + (*end - begin) / 2;
+        detail::LoopTask *task = &job->tasks[idx];
+        *task = {job, middle, *end};
+        if (!workers_[worker]->push(task, job)) {
+            return false;
+        }
+        *end = middle;
+
+        if (sleepers_.load(std::memory_order_seq_cst) > 0) {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                ++epoch_;
+            }
+            wake_.notify_all();
+        }
+        return true;
+    }
+
+    /**
+     * Steal a range from other workers and run it.
+     *
+     * @param worker Worker index.
+     * @param job Loop to steal ranges of, nullptr for any loop.
+     * @return True if some range was run.
+     */
+    bool steal_and_run(size_t worker, Job *job)
+    {
+        size_t n = workers_.size();
+        for (size_t i = 1; i < n; ++i) {
+            size_t victim = (worker + i) % n;
+            if (detail::LoopTask *task = workers_[victim]->steal(job)) {
+                run_range(worker, static_cast<Job *>(task->job), task->begin, task->end);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool has_work() const
+    {
+        for (const auto &deque : workers_) {
+            if (!deque->empty()) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void work(size_t worker)
+    {
+        current_worker() = {this, worker};
+
+        /// Idle worker spins for a while before going to sleep, loops often come in bursts.
+        constexpr int spins = 16;
+
+        size_t seen = 0;
+        for (;;) {
+            bool found = false;
+            for (int i = 0; (i < spins) && !found; ++i) {
+                found = steal_and_run(worker, nullptr);
+                if (!found) {
+                    std::this_thread::yield();
+                }
+            }
+            if (found) {
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(mutex_);
+            if (stop_) {
+                return;
+            }
+            if (epoch_ != seen) {
+                seen = epoch_;
+                continue;
+            }
+
+            /// Ranges pushed after this check see the sleeper and bump the epoch.
+            sleepers_.fetch_add(1, std::memory_order_seq_cst);
+            if (!has_work()) {
+                wake_.wait(lock, [this, seen] { return stop_ || (epoch_ != seen); });
+            }
+            sleepers_.fetch_sub(1, std::memory_order_relaxed);
+            seen = epoch_;
+        }
+    }
+
+private:
+    std::vector<std::unique_ptr<detail::TaskDeque>> workers_;
+    std::vector<std::thread> threads_;
+    /// Worker 0 is shared by outside callers.
+    std::mutex outside_mutex_;
+
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::atomic<size_t> sleepers_;
+    size_t epoch_;
+    bool stop_;
+};
+
+}  // namespace simple_graph
@@ -0,0 +1,252 @@
+#pragma once
+
+#include <algorithm>
+#include <iterator>
+#include <memory_resource>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "bitmap.hpp"
+#include "graph.hpp"
+
+namespace simple_graph {
+
+/**
+ * Per-vertex values keyed by arbitrary vertex indices.
+ *
+ * @tparam T Typename for values.
+ */
+template<typename T>
+class SparseVertexMap {
+    using Map = std::pmr::unordered_map<vertex_index_t, T>;
+
+public:
+    using const_iterator = typename Map::const_iterator;
+
+    SparseVertexMap() : map_() {}
+
+    /**
+     * Constructor.
+     *
+     * @param resource Memory resource to allocate values from.
+     */
+    explicit SparseVertexMap(std::pmr::memory_resource *resource) : map_(resource) {}
+
+    size_t size() const { return map_.size(); }
+
+    bool contains(vertex_index_t idx) const
+    {
+        return map_.count(idx) > 0;
+    }
+
+    /**
+     * Get value of the vertex.
+     *
+     * @param idx Vertex index.
+     * @return Pointer to the value or nullptr if there is no such vertex.
+     */
+    const T *find(vertex_index_t idx) const
+    {
+        auto it = map_.find(idx);
+        return it == map_.end() ? nullptr : &it->second;
+    }
+
+    T *find(vertex_index_t idx)
+    {
+        auto it = map_.find(idx);
+        return it == map_.end() ? nullptr : &it->second;
+    }
+
+    const T &at(vertex_index_t idx) const
+    {
+        return map_.at(idx);
+    }
+
+    /**
+     * Get value of the vertex adding default one if there is no such vertex.
+     */
+    T &operator[](vertex_index_t idx)
+    {
+        return map_[idx];
+    }
+
+    /**
+     * Add value of the vertex if there is no such vertex yet, value is constructed in place.
+     *
+     * @param idx Vertex index.
+     * @param args Arguments of value constructor.
+     * @return True if value was added, false otherwise.
+     */
+    template<typename... Args>
+    bool emplace(vertex_index_t idx, Args &&...args)
+    {
+        return map_.try_emplace(idx, std::forward<Args>(args)...).second;
+    }
+
+    void erase(vertex_index_t idx)
+    {
+        map_.erase(idx);
+    }
+
+    const_iterator begin() const { return map_.begin(); }
+    const_iterator end() const { return map_.end(); }
+
+private:
+    Map map_;
+};
+
+/**
+ * Per-vertex values stored in an array indexed by vertex index.
+ *
+ * Lookup is a bounds check and a bit test instead of hashing. Memory is proportional to the maximal vertex
+ * index, so indices are expected to be dense, see IdMap to make them so.
+ *
+ * @tparam T Typename for values.
+ */
+template<typename T>
+class DenseVertexMap {
+public:
+    /**
+     * Iterator over present vertices, dereferences to pair of vertex index and reference to its value.
+     */
+    class const_iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = std::pair<vertex_index_t, const T&>;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = value_type;
+
+        const_iterator(const DenseVertexMap *map, size_t pos) : map_(map), pos_(pos)
+        {
+            skip_absent();
+        }
+
+        value_type operator*() const
+        {
+            return {static_cast<vertex_index_t>(pos_), map_->values_[pos_]};
+        }
+
+        const_iterator &operator++()
+        {
+            ++pos_;
+            skip_absent();
+            return *this;
+        }
+
+        bool operator==(const const_iterator &it) const { return pos_ == it.pos_; }
+        bool operator!=(const const_iterator &it) const { return pos_ != it.pos_; }
+
+    private:
+        void skip_absent()
+        {
+            while ((pos_ < map_->values_.size()) && !map_->present_.test(pos_)) {
+                ++pos_;
+            }
+        }
+
+    private:
+        const DenseVertexMap *map_;
+        size_t pos_;
+    };
+
+    DenseVertexMap() : values_(), present_() {}
+
+    /**
+     * Constructor.
+     *
+     * @param resource Memory resource to allocate values from.
+     */
+    explicit DenseVertexMap(std::pmr::memory_resource *resource) : values_(resource), present_(resource) {}
+
+    size_t size() const { return present_.count(); }
+
+    bool contains(vertex_index_t idx) const
+    {
+        return (idx >= 0) && (static_cast<size_t>(idx) < values_.size()) && present_.test(idx);
+    }
+
+    /**
+     * Get value of the vertex.
+     *
+     * @param idx Vertex index.
+     * @return Pointer to the value or nullptr if there is no such vertex.
+     */
+    const T *find(vertex_index_t idx) const
+    {
+        return contains(idx) ? &values_[idx] : nullptr;
+    }
+
+    T *find(vertex_index_t idx)
+    {
+        return contains(idx) ? &values_[idx] : nullptr;
+    }
+
+    const T &at(vertex_index_t idx) const
+    {
+        if (!contains(idx)) {
+            throw std::out_of_range("Vertex index is not presented");
+        }
+        return values_[idx];
+    }
+
+    /**
+     * Get value of the vertex adding default one if there is no such vertex.
+     */
+    T &operator[](vertex_index_t idx)
+    {
+        grow(idx);
+        present_.set(idx);
+        return values_[idx];
+    }
+
+    /**
+     * Add value of the vertex if there is no such vertex yet.
+     *
+     * @param idx Vertex index.
+     * @param args Arguments of value constructor.
+     * @return True if value was added, false otherwise.
+     * @note Array slot already holds a default value, so the new value is constructed aside and moved into it.
+     */
+    template<typename... Args>
+    bool emplace(vertex_index_t idx, Args &&...args)
+    {
+        if (contains(idx)) {
+            return false;
+        }
+        grow(idx);
+        values_[idx] = T(std::forward<Args>(args)...);
+        present_.set(idx);
+        return true;
+    }
+
+    void erase(vertex_index_t idx)
+    {
+        if (contains(idx)) {
+            values_[idx] = T();
+            present_.reset(idx);
+        }
+    }
+
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, values_.size()); }
+
+private:
+    void grow(vertex_index_t idx)
+    {
+        if (idx < 0) {
+            throw std::out_of_range("Vertex with invalid index");
+        }
+        if (static_cast<size_t>(idx) >= values_.size()) {
+            values_.resize(idx + 1);
+            present_.resize(idx + 1);
+        }
+    }
+
+private:
+    std::pmr::vector<T> values_;
+    Bitmap present_;
+};
+
+}  // namespace simple_graph
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <deque>
+#include <limits>
+#include <random>
+#include <vector>
+#include "simple_graph/list_graph.hpp"
+
+/**
+ * Graphs and reference levels shared by tests of BFS variants.
+ */
+namespace bfs_test_util {
+
+using simple_graph::vertex_index_t;
+
+const size_t unreached = std::numeric_limits<size_t>::max();
+
+/**
+ * Random graph with vertex data equal to the index.
+ *
+ * @param n Number of vertices.
+ * @param degree Number of random edges from a vertex, edges to itself are dropped.
+ * @param seed Random seed.
+ * @param dense Vertices below it get dense_degree edges, so some levels are expanded bottom-up.
+ * @param dense_degree Number of random edges from dense vertices.
+ */
+template<bool Dir>
+simple_graph::ListGraph<Dir, int, int, int> make_random(int n, int degree, unsigned seed, int dense = 0,
+        int dense_degree = 32)
+{
+    simple_graph::ListGraph<Dir, int, int, int> g;
+    for (int i = 0; i < n; ++i) {
+        g.add_vertex(simple_graph::Vertex<int>(i, i));
+    }
+    std::mt19937 gen(seed);
+    std::uniform_int_distribution<int> vertex(0, n - 1);
+    std::vector<simple_graph::Edge<int, int>> edges;
+    for (int i = 0; i < n; ++i) {
+        int num = i < dense ? dense_degree : degree;
+        for (int k = 0; k < num; ++k) {
+            int j = vertex(gen);
+            if (i != j) {
+                edges.emplace_back(i, j, 0, 1);
+            }
+        }
+    }
+    g.add_edges(edges);
+    return g;
+}
+
+/**
+ * Levels computed with queue-based sequential BFS.
+ *
+ * @param mode Passed to out_neighbours(), 1 to walk filtered edges too, 0 to skip them.
+ */
+template<typename G>
+std::vector<size_t> reference_levels(const G &g, vertex_index_t start_idx, int mode)
+{
+    std::vector<size_t> level(static_cast<size_t>(simple_graph::vertex_bound(g)), unreached);
+    std::deque<vertex_index_t> queue = {start_idx};
+    level[start_idx] = 0;
+    while (!queue.empty()) {
+        vertex_index_t u = queue.front();
+        queue.pop_front();
+        for (const auto &n : g.out_neighbours(u, mode)) {
+            if (level[n.idx] == unreached) {
+                level[n.idx] = level[u] + 1;
+                queue.push_back(n.idx);
+            }
+        }
+    }
+    return level;
+}
+
+}  // namespace bfs_test_util
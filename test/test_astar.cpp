@@ -1,4 +1,5 @@
 #include <cmath>
+#include <functional>
 #include <gtest/gtest.h>
 #include "simple_graph/list_graph.hpp"
 #include "simple_graph/algorithm/astar.hpp"
@@ -64,6 +65,13 @@ TEST_F(ListGraphTest, test_undirected_astar_long)
     EXPECT_EQ(0, path[0]);
     EXPECT_EQ(1, path[1]);
     EXPECT_EQ(4, path[4]);
+
+    /// Lambda heuristic gives the same path.
+    std::vector<vertex_index_t> lambda_path;
+    ASSERT_TRUE(astar(undirected_graph, 0, 7, [this](vertex_index_t c, vertex_index_t r) {
+        return dist(undirected_graph, c, r);
+    }, &lambda_path));
+    EXPECT_EQ(path, lambda_path);
 }
 
 TEST_F(ListGraphTest, test_undirected_astar_short)
@@ -193,6 +201,11 @@ TEST_F(ListGraphTest, test_big_graph)
 
     std::vector<vertex_index_t> path;
     EXPECT_TRUE(simple_graph::astar(g, 0, size * size - 1, heuristic, &path));
+    EXPECT_EQ(2 * size - 1, path.size());
+
+    std::vector<vertex_index_t> binary_heap_path;
+    EXPECT_TRUE(simple_graph::astar<2>(g, 0, size * size - 1, heuristic, &binary_heap_path));
+    EXPECT_EQ(path.size(), binary_heap_path.size());
 }
 
 }  // namespace
@@ -0,0 +1,113 @@
+#include <cstdlib>
+#include <limits>
+#include <random>
+#include <vector>
+#include <gtest/gtest.h>
+#include "simple_graph/list_graph.hpp"
+#include "simple_graph/csr_graph.hpp"
+#include "simple_graph/algorithm/batch.hpp"
+
+namespace {
+
+using simple_graph::vertex_index_t;
+using Query = std::pair<vertex_index_t, vertex_index_t>;
+
+class BatchSearchTest : public ::testing::Test {
+protected:
+    virtual void SetUp() {
+        /// Grid with random weights, so that shortest paths are unique with high probability.
+        std::mt19937 gen(7);
+        std::uniform_int_distribution<int> weight(1, 100);
+        for (int i = 0; i < n * n; ++i) {
+            g.add_vertex(simple_graph::Vertex<int>(i, i));
+        }
+        for (int r = 0; r < n; ++r) {
+            for (int c = 0; c < n; ++c) {
+                if (c + 1 < n) {
+                    g.add_edge(simple_graph::Edge<int, int>(r * n + c, r * n + c + 1, 0, weight(gen)));
+                }
+                if (r + 1 < n) {
+                    g.add_edge(simple_graph::Edge<int, int>(r * n + c, (r + 1) * n + c, 0, weight(gen)));
+                }
+            }
+        }
+
+        std::uniform_int_distribution<vertex_index_t> vertex(0, n * n - 1);
+        for (int i = 0; i < 200; ++i) {
+            queries.emplace_back(vertex(gen), vertex(gen));
+        }
+        queries.emplace_back(0, 0);
+        queries.emplace_back(0, n * n);
+        queries.emplace_back(-1, 0);
+    }
+
+    const int n = 16;
+    simple_graph::ListGraph<false, int, int, int> g;
+    std::vector<Query> queries;
+};
+
+TEST_F(BatchSearchTest, test_dijkstra)
+{
+    for (size_t threads : {1, 2, 4}) {
+        simple_graph::ThreadPool pool(threads);
+        simple_graph::BatchSearch<decltype(g)> batch(g, &pool);
+        EXPECT_EQ(threads, batch.threads());
+        auto results = batch.dijkstra(queries);
+        ASSERT_EQ(queries.size(), results.size());
+
+        for (size_t i = 0; i < queries.size(); ++i) {
+            std::vector<vertex_index_t> path;
+            auto is_goal = simple_graph::by_index([&](vertex_index_t idx) { return idx == queries[i].second; });
+            bool found = simple_graph::dijkstra(g, queries[i].first, is_goal, &path);
+            EXPECT_EQ(found, results[i].found);
+            EXPECT_EQ(path, results[i].path);
+        }
+
+        EXPECT_TRUE(results[200].found);
+        EXPECT_EQ(0, results[200].distance);
+        EXPECT_EQ(std::vector<vertex_index_t>({0}), results[200].path);
+        EXPECT_FALSE(results[201].found);
+        EXPECT_EQ(std::numeric_limits<int>::max(), results[201].distance);
+        EXPECT_FALSE(results[202].found);
+    }
+}
+
+TEST_F(BatchSearchTest, test_same_distances)
+{
+    simple_graph::ThreadPool pool(3);
+    simple_graph::BatchSearch<decltype(g)> batch(g, &pool);
+    auto heuristic = [](vertex_index_t, vertex_index_t) { return 0.0f; };
+    auto dijkstra = batch.dijkstra(queries);
+    auto astar = batch.astar(queries, heuristic);
+    auto bellman_ford = batch.bellman_ford(queries);
+
+    for (size_t i = 0; i < queries.size(); ++i) {
+        EXPECT_EQ(dijkstra[i].found, astar[i].found);
+        EXPECT_EQ(dijkstra[i].found, bellman_ford[i].found);
+        EXPECT_EQ(dijkstra[i].distance, astar[i].distance);
+        EXPECT_EQ(dijkstra[i].distance, bellman_ford[i].distance);
+    }
+
+    /// Contexts are reused by the next batch.
+    EXPECT_EQ(dijkstra[5].path, batch.dijkstra(queries)[5].path);
+}
+
+TEST_F(BatchSearchTest, test_csr)
+{
+    simple_graph::CsrGraph<false, int, int, int> cg(g);
+    simple_graph::BatchSearch<decltype(cg)> csr_batch(cg);
+    simple_graph::BatchSearch<decltype(g)> list_batch(g);
+    auto csr = csr_batch.dijkstra(queries);
+    auto list = list_batch.dijkstra(queries);
+    for (size_t i = 0; i < queries.size(); ++i) {
+        EXPECT_EQ(list[i].distance, csr[i].distance);
+    }
+}
+
+}  // namespace
+
+int main(int argc, char **argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -79,6 +79,9 @@ TEST_F(UndirectedListGraphTest, test_bellman_ford_no_path)
     std::vector<vertex_index_t> path;
     EXPECT_EQ(false, simple_graph::bellman_ford(undirected_graph, 0, 3, &path));
     EXPECT_EQ(0, path.size());
+    EXPECT_EQ(false, simple_graph::bellman_ford(undirected_graph, 0, 4, &path));
+    EXPECT_EQ(false, simple_graph::bellman_ford(undirected_graph, 4, 0, &path));
+    EXPECT_EQ(0, path.size());
 }
 
 TEST_F(UndirectedListGraphTest, test_bellman_ford_negative_weigths)
@@ -168,6 +171,23 @@ TEST_F(DirectedListGraphTest, test_bellman_ford_reverse)
     EXPECT_EQ(1, path[4]);
 }
 
+TEST_F(DirectedListGraphTest, test_bellman_ford_negative_self_loop)
+{
+    for (vertex_index_t i = 0; i < 2; ++i) {
+        directed_graph.add_vertex(simple_graph::Vertex<int>(i));
+    }
+
+    directed_graph.add_edge(simple_graph::Edge<int, ssize_t>(0, 1, 0, 1));
+    std::vector<vertex_index_t> path;
+    ASSERT_EQ(true, simple_graph::bellman_ford(directed_graph, 0, 1, &path));
+    EXPECT_EQ(2, path.size());
+
+    directed_graph.add_edge(simple_graph::Edge<int, ssize_t>(1, 1, 0, -5));
+    path.clear();
+    EXPECT_EQ(false, simple_graph::bellman_ford(directed_graph, 0, 1, &path));
+    EXPECT_EQ(0, path.size());
+}
+
 }  // namespace
 
 int main(int argc, char **argv)
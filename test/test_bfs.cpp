@@ -1,3 +1,4 @@
+#include <functional>
 #include <gtest/gtest.h>
 #include "simple_graph/list_graph.hpp"
 #include "simple_graph/algorithm/bfs.hpp"
@@ -53,6 +54,24 @@ TEST_F(ListGraphUndirectedTest, test_bfs_reverse_order)
     EXPECT_EQ(true, bfs(undirected_graph, 3, f, &path));
 }
 
+TEST_F(ListGraphUndirectedTest, test_bfs_by_index)
+{
+    for (size_t i = 0; i < 4; ++i) {
+        undirected_graph.add_vertex(simple_graph::Vertex<size_t>(i, 10 - i));
+    }
+    undirected_graph.add_edge(simple_graph::Edge<int, size_t>(0, 1, 0));
+    undirected_graph.add_edge(simple_graph::Edge<int, size_t>(1, 2, 0));
+    undirected_graph.add_edge(simple_graph::Edge<int, size_t>(2, 3, 0));
+
+    std::vector<vertex_index_t> path;
+    EXPECT_TRUE(bfs(undirected_graph, 0, simple_graph::by_index([](vertex_index_t idx) { return idx == 2; }), &path));
+    EXPECT_EQ(std::vector<vertex_index_t>({0, 1, 2}), path);
+
+    path.clear();
+    EXPECT_TRUE(bfs(undirected_graph, 0, [](const size_t &c) { return c == 7; }, &path));
+    EXPECT_EQ(std::vector<vertex_index_t>({0, 1, 2, 3}), path);
+}
+
 }  // namespace
 
 int main(int argc, char **argv)
@@ -0,0 +1,75 @@
+#include <gtest/gtest.h>
+#include "simple_graph/bitmap.hpp"
+
+namespace {
+
+TEST(BitmapTest, test_set_reset)
+{
+    simple_graph::Bitmap bitmap(130);
+    EXPECT_EQ(130, bitmap.size());
+    EXPECT_TRUE(bitmap.none());
+
+    bitmap.set(0);
+    bitmap.set(64);
+    bitmap.set(129);
+    bitmap.set(129);
+    EXPECT_EQ(3, bitmap.count());
+    EXPECT_TRUE(bitmap.test(64));
+    EXPECT_FALSE(bitmap.test(63));
+
+    bitmap.reset(64);
+    bitmap.reset(65);
+    EXPECT_EQ(2, bitmap.count());
+    EXPECT_FALSE(bitmap.test(64));
+
+    bitmap.assign(1, true);
+    EXPECT_TRUE(bitmap.test(1));
+    bitmap.clear();
+    EXPECT_TRUE(bitmap.none());
+    EXPECT_EQ(130, bitmap.size());
+}
+
+TEST(BitmapTest, test_resize)
+{
+    simple_graph::Bitmap bitmap;
+    bitmap.resize(10);
+    bitmap.set(9);
+    bitmap.set(3);
+
+    /// Truncated bits are forgotten and don't reappear after growing back.
+    bitmap.resize(5);
+    EXPECT_EQ(1, bitmap.count());
+    bitmap.resize(100);
+    EXPECT_FALSE(bitmap.test(9));
+    EXPECT_TRUE(bitmap.test(3));
+    EXPECT_EQ(1, bitmap.count());
+}
+
+TEST(BitmapTest, test_find_next_clear)
+{
+    simple_graph::Bitmap bitmap(200);
+    for (size_t i = 0; i < 150; ++i) {
+        bitmap.set(i);
+    }
+    bitmap.reset(70);
+
+    EXPECT_EQ(70, bitmap.find_next_clear(0));
+    EXPECT_EQ(70, bitmap.find_next_clear(70));
+    EXPECT_EQ(150, bitmap.find_next_clear(71));
+    EXPECT_EQ(199, bitmap.find_next_clear(199));
+    EXPECT_EQ(200, bitmap.find_next_clear(200));
+
+    /// Bits past the size are never reported.
+    for (size_t i = 150; i < 200; ++i) {
+        bitmap.set(i);
+    }
+    EXPECT_EQ(200, bitmap.find_next_clear(71));
+}
+
+}  // namespace
+
+int main(int argc, char **argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
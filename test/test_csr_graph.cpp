@@ -0,0 +1,117 @@
+#include <functional>
+#include <gtest/gtest.h>
+#include "simple_graph/csr_graph.hpp"
+#include "simple_graph/algorithm/astar.hpp"
+#include "simple_graph/algorithm/bellman_ford.hpp"
+#include "simple_graph/algorithm/bfs.hpp"
+#include "simple_graph/algorithm/dfs.hpp"
+
+namespace {
+
+using simple_graph::vertex_index_t;
+
+class CsrGraphTest : public ::testing::Test {
+protected:
+    virtual void SetUp() {
+        for (int i = 0; i < 6; ++i) {
+            directed_graph.add_vertex(simple_graph::Vertex<int>(i, i));
+            undirected_graph.add_vertex(simple_graph::Vertex<int>(i, i));
+        }
+
+        std::vector<std::tuple<int, int, int>> edges = {
+                {0, 1, 1}, {1, 2, 1}, {2, 3, 1}, {0, 4, 5}, {4, 3, 1}, {3, 5, 2}
+        };
+        for (const auto &e : edges) {
+            directed_graph.add_edge(simple_graph::Edge<int, int>(std::get<0>(e), std::get<1>(e), 0, std::get<2>(e)));
+            undirected_graph.add_edge(simple_graph::Edge<int, int>(std::get<1>(e), std::get<0>(e), 0, std::get<2>(e)));
+        }
+    }
+
+    simple_graph::ListGraph<true, int, int, int> directed_graph;
+    simple_graph::ListGraph<false, int, int, int> undirected_graph;
+};
+
+TEST_F(CsrGraphTest, test_freeze)
+{
+    auto g = simple_graph::freeze(directed_graph);
+
+    ASSERT_EQ(6, g.vertex_num());
+    ASSERT_EQ(6, g.edge_num());
+    EXPECT_EQ(4, g.vertex(4).data());
+    EXPECT_THROW(g.vertex(6), std::out_of_range);
+
+    EXPECT_EQ(directed_graph.outbounds(0, 0), g.outbounds(0, 0));
+    EXPECT_EQ(directed_graph.inbounds(3), g.inbounds(3));
+    EXPECT_EQ(5, g.edge(0, 4).weight());
+    EXPECT_THROW(g.edge(4, 0), std::out_of_range);
+    EXPECT_TRUE(g.edge_exists(simple_graph::Edge<int, int>(4, 3, 0)));
+    EXPECT_FALSE(g.edge_exists(simple_graph::Edge<int, int>(3, 4, 0)));
+
+    int visited_edges_num = 0;
+    for (const auto &edge : g.edges()) {
+        EXPECT_EQ(directed_graph.edge(edge.idx1(), edge.idx2()).weight(), edge.weight());
+        ++visited_edges_num;
+    }
+    EXPECT_EQ(6, visited_edges_num);
+
+    EXPECT_THROW(g.add_vertex(simple_graph::Vertex<int>(6, 6)), std::logic_error);
+    EXPECT_THROW(g.add_edge(simple_graph::Edge<int, int>(0, 5, 0)), std::logic_error);
+}
+
+TEST_F(CsrGraphTest, test_freeze_undirected)
+{
+    auto g = simple_graph::freeze(undirected_graph);
+
+    ASSERT_EQ(6, g.edge_num());
+    EXPECT_EQ(undirected_graph.outbounds(3, 0), g.outbounds(3, 0));
+    EXPECT_EQ(undirected_graph.inbounds(3), g.inbounds(3));
+    EXPECT_EQ(5, g.edge(4, 0).weight());
+    EXPECT_EQ(5, g.edge(0, 4).weight());
+}
+
+TEST_F(CsrGraphTest, test_freeze_filtered)
+{
+    directed_graph.filter_edge(simple_graph::Edge<int, int>(2, 3, 0));
+    auto g = simple_graph::freeze(directed_graph);
+
+    EXPECT_EQ(5, g.edge_num());
+    EXPECT_EQ(0, g.outbounds(2, 0).size());
+    EXPECT_EQ(1, g.inbounds(3).size());
+}
+
+TEST_F(CsrGraphTest, test_algorithms)
+{
+    auto g = simple_graph::freeze(directed_graph);
+
+    std::function<bool(int)> pred = [](int c) { return c == 5; };
+    std::vector<vertex_index_t> expected;
+    std::vector<vertex_index_t> path;
+    ASSERT_TRUE(simple_graph::bfs(directed_graph, 0, pred, &expected));
+    ASSERT_TRUE(simple_graph::bfs(g, 0, pred, &path));
+    EXPECT_EQ(expected, path);
+
+    expected.clear();
+    path.clear();
+    ASSERT_TRUE(simple_graph::dfs(directed_graph, 0, pred, &expected));
+    ASSERT_TRUE(simple_graph::dfs(g, 0, pred, &path));
+    EXPECT_EQ(expected, path);
+
+    std::function<float(vertex_index_t, vertex_index_t)> heuristic = [](vertex_index_t, vertex_index_t) {
+        return 0.0f;
+    };
+    path.clear();
+    ASSERT_TRUE(simple_graph::astar(g, 0, 5, heuristic, &path));
+    EXPECT_EQ(std::vector<vertex_index_t>({0, 1, 2, 3, 5}), path);
+
+    path.clear();
+    ASSERT_TRUE(simple_graph::bellman_ford(g, 0, 5, &path));
+    EXPECT_EQ(std::vector<vertex_index_t>({0, 1, 2, 3, 5}), path);
+}
+
+}  // namespace
+
+int main(int argc, char **argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -1,3 +1,4 @@
+#include <functional>
 #include <gtest/gtest.h>
 #include "simple_graph/list_graph.hpp"
 #include "simple_graph/algorithm/dfs.hpp"
@@ -0,0 +1,145 @@
+#include <functional>
+#include <random>
+#include <gtest/gtest.h>
+#include "simple_graph/list_graph.hpp"
+#include "simple_graph/algorithm/bellman_ford.hpp"
+#include "simple_graph/algorithm/dijkstra.hpp"
+
+namespace {
+
+using simple_graph::vertex_index_t;
+
+class DijkstraTest : public ::testing::Test {
+protected:
+    virtual void SetUp() {
+        for (int i = 0; i < 6; ++i) {
+            directed_graph.add_vertex(simple_graph::Vertex<int>(i, i));
+            undirected_graph.add_vertex(simple_graph::Vertex<int>(i, i));
+        }
+
+        /// Direct edge 0 -> 5 is shorter by hops but longer by weight.
+        std::vector<std::tuple<int, int, float>> edges = {
+                {0, 1, 1.0f}, {1, 2, 1.5f}, {2, 5, 1.0f}, {0, 5, 10.0f}, {1, 3, 0.5f}, {3, 2, 0.5f}
+        };
+        for (const auto &e : edges) {
+            directed_graph.add_edge(simple_graph::Edge<int, float>(std::get<0>(e), std::get<1>(e), 0, std::get<2>(e)));
+            undirected_graph.add_edge(simple_graph::Edge<int, float>(std::get<0>(e), std::get<1>(e), 0, std::get<2>(e)));
+        }
+    }
+
+    simple_graph::ListGraph<true, int, int, float> directed_graph;
+    simple_graph::ListGraph<false, int, int, float> undirected_graph;
+};
+
+TEST_F(DijkstraTest, test_directed_path)
+{
+    std::vector<vertex_index_t> path;
+    std::function<bool(int)> f = [](int c) { return c == 5; };
+    ASSERT_TRUE(simple_graph::dijkstra(directed_graph, 0, f, &path));
+    EXPECT_EQ(std::vector<vertex_index_t>({0, 1, 3, 2, 5}), path);
+
+    path.clear();
+    std::function<bool(int)> g = [](int c) { return c == 0; };
+    EXPECT_FALSE(simple_graph::dijkstra(directed_graph, 5, g, &path));
+    EXPECT_EQ(0, path.size());
+}
+
+TEST_F(DijkstraTest, test_undirected_path)
+{
+    std::vector<vertex_index_t> path;
+    std::function<bool(int)> f = [](int c) { return c == 0; };
+    ASSERT_TRUE(simple_graph::dijkstra<2>(undirected_graph, 5, f, &path));
+    EXPECT_EQ(std::vector<vertex_index_t>({5, 2, 3, 1, 0}), path);
+
+    /// Start vertex is checked too.
+    path.clear();
+    ASSERT_TRUE(simple_graph::dijkstra(undirected_graph, 0, f, &path));
+    EXPECT_EQ(std::vector<vertex_index_t>({0}), path);
+}
+
+TEST_F(DijkstraTest, test_callable_predicates)
+{
+    /// Lambda taking vertex data by reference.
+    std::vector<vertex_index_t> path;
+    ASSERT_TRUE(simple_graph::dijkstra(directed_graph, 0, [](const int &c) { return c == 5; }, &path));
+    EXPECT_EQ(std::vector<vertex_index_t>({0, 1, 3, 2, 5}), path);
+
+    /// Lambda taking vertex index.
+    path.clear();
+    auto is_goal = simple_graph::by_index([](vertex_index_t idx) { return idx == 0; });
+    ASSERT_TRUE(simple_graph::dijkstra(undirected_graph, 5, is_goal, &path));
+    EXPECT_EQ(std::vector<vertex_index_t>({5, 2, 3, 1, 0}), path);
+}
+
+TEST_F(DijkstraTest, test_one_to_all)
+{
+    directed_graph.add_vertex(simple_graph::Vertex<int>(6, 6));
+
+    std::vector<float> distance;
+    std::vector<vertex_index_t> predecessor;
+    ASSERT_TRUE(simple_graph::dijkstra(directed_graph, 0, &distance, &predecessor));
+    ASSERT_EQ(7, distance.size());
+    EXPECT_EQ(std::vector<float>({0.0f, 1.0f, 2.0f, 1.5f, std::numeric_limits<float>::max(), 3.0f,
+            std::numeric_limits<float>::max()}), distance);
+    EXPECT_EQ(std::vector<vertex_index_t>({-1, 0, 3, 1, -1, 2, -1}), predecessor);
+
+    for (vertex_index_t v : {1, 2, 3, 5}) {
+        std::vector<vertex_index_t> path;
+        ASSERT_TRUE(simple_graph::bellman_ford(directed_graph, 0, v, &path));
+        EXPECT_EQ(v, path.back());
+        EXPECT_EQ(predecessor[v], path[path.size() - 2]);
+    }
+
+    EXPECT_FALSE(simple_graph::dijkstra(directed_graph, 7, &distance, &predecessor));
+}
+
+TEST(DijkstraIntegerTest, test_random_graph)
+{
+    constexpr int size = 200;
+
+    std::mt19937 gen(7);
+    std::uniform_int_distribution<int> vertex_dist(0, size - 1);
+    std::uniform_int_distribution<int> weight_dist(0, 1000);
+
+    simple_graph::ListGraph<true, int, int, int> g;
+    simple_graph::ListGraph<true, int, int, double> fg;
+    for (int i = 0; i < size; ++i) {
+        g.add_vertex(simple_graph::Vertex<int>(i, i));
+        fg.add_vertex(simple_graph::Vertex<int>(i, i));
+    }
+    for (int i = 0; i < size * 4; ++i) {
+        int idx1 = vertex_dist(gen);
+        int idx2 = vertex_dist(gen);
+        int weight = weight_dist(gen);
+        if ((idx1 != idx2) && !g.edge_exists(simple_graph::Edge<int, int>(idx1, idx2, 0))) {
+            g.add_edge(simple_graph::Edge<int, int>(idx1, idx2, 0, weight));
+            fg.add_edge(simple_graph::Edge<int, double>(idx1, idx2, 0, weight));
+        }
+    }
+
+    /// Integer weights use radix heap, floating-point ones use comparison heap.
+    std::vector<int> distance;
+    std::vector<vertex_index_t> predecessor;
+    ASSERT_TRUE(simple_graph::dijkstra(g, 0, &distance, &predecessor));
+
+    std::vector<double> fdistance;
+    std::vector<vertex_index_t> fpredecessor;
+    ASSERT_TRUE(simple_graph::dijkstra(fg, 0, &fdistance, &fpredecessor));
+
+    for (int i = 0; i < size; ++i) {
+        if (distance[i] == std::numeric_limits<int>::max()) {
+            EXPECT_EQ(std::numeric_limits<double>::max(), fdistance[i]);
+        }
+        else {
+            EXPECT_EQ(distance[i], fdistance[i]);
+        }
+    }
+}
+
+}  // namespace
+
+int main(int argc, char **argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
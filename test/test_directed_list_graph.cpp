@@ -1,3 +1,9 @@
+#include <map>
+#include <memory_resource>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
 #include <gtest/gtest.h>
 #include "simple_graph/list_graph.hpp"
 #include "simple_graph/algorithm/bfs.hpp"
@@ -89,6 +95,104 @@ TEST_F(ListGraphDirectedTest, test_rm_vertex)
     EXPECT_EQ(0, directed_graph_empty.vertex_num());
 }
 
+TEST_F(ListGraphDirectedTest, test_rm_vertices)
+{
+    directed_graph.add_edge(simple_graph::Edge<int, int>(2, 4, 0, 11));
+    directed_graph.add_edge(simple_graph::Edge<int, int>(4, 2, 0, 12));
+    directed_graph.add_edge(simple_graph::Edge<int, int>(4, 6, 0, 13));
+    directed_graph.add_edge(simple_graph::Edge<int, int>(6, 23, 0, 14));
+    directed_graph.add_edge(simple_graph::Edge<int, int>(23, 23, 0, 15));
+    directed_graph.add_edge(simple_graph::Edge<int, int>(23, 4, 0, 16));
+    directed_graph.filter_edge(simple_graph::Edge<int, int>(23, 4, 0));
+    directed_graph.filter_edge(simple_graph::Edge<int, int>(6, 2, 0));
+
+    EXPECT_THROW(directed_graph.rm_vertices({2, 5}), std::out_of_range);
+    EXPECT_EQ(4, directed_graph.vertex_num());
+    EXPECT_EQ(6, directed_graph.edge_num());
+
+    directed_graph.rm_vertices({23, 2, 23});
+    EXPECT_EQ(2, directed_graph.vertex_num());
+    EXPECT_EQ(1, directed_graph.edge_num());
+    EXPECT_EQ(13, directed_graph.edge(4, 6).weight());
+    EXPECT_EQ(std::set<vertex_index_t>({6}), directed_graph.outbounds(4, 1));
+    EXPECT_EQ(std::set<vertex_index_t>(), directed_graph.outbounds(6, 1));
+    EXPECT_EQ(std::set<vertex_index_t>(), directed_graph.inbounds(4));
+    EXPECT_EQ(std::set<vertex_index_t>({4}), directed_graph.inbounds(6));
+    EXPECT_THROW(directed_graph.vertex(23), std::out_of_range);
+
+    /// Filters of removed edges are dropped with the vertices.
+    directed_graph.add_vertex(simple_graph::Vertex<char>(2, 'a'));
+    directed_graph.add_vertex(simple_graph::Vertex<char>(23, 'd'));
+    directed_graph.add_edge(simple_graph::Edge<int, int>(23, 4, 0));
+    directed_graph.add_edge(simple_graph::Edge<int, int>(6, 2, 0));
+    EXPECT_EQ(std::set<vertex_index_t>({4}), directed_graph.outbounds(23, 0));
+    EXPECT_EQ(std::set<vertex_index_t>({2}), directed_graph.outbounds(6, 0));
+}
+
+TEST_F(ListGraphDirectedTest, test_readd_vertex)
+{
+    directed_graph.add_edge(simple_graph::Edge<int, int>(2, 4, 0, 11));
+    directed_graph.add_edge(simple_graph::Edge<int, int>(4, 6, 0, 12));
+    directed_graph.add_edge(simple_graph::Edge<int, int>(6, 23, 0, 13));
+
+    /// Existing vertex keeps its data and edges.
+    directed_graph.add_vertex(simple_graph::Vertex<char>(4, 'x'));
+    directed_graph.add_vertex(simple_graph::Vertex<char>(6, 'y'));
+    EXPECT_EQ(4, directed_graph.vertex_num());
+    EXPECT_EQ(3, directed_graph.edge_num());
+    EXPECT_EQ('b', directed_graph.vertex(4).data());
+    EXPECT_EQ(std::set<vertex_index_t>({4}), directed_graph.outbounds(2, 0));
+    EXPECT_EQ(12, directed_graph.edge(4, 6).weight());
+
+    /// Edges of re-added vertices are removed with them.
+    directed_graph.rm_vertex(4);
+    EXPECT_EQ(1, directed_graph.edge_num());
+    EXPECT_EQ(std::set<vertex_index_t>(), directed_graph.outbounds(2, 0));
+    directed_graph.rm_vertices({6});
+    EXPECT_EQ(0, directed_graph.edge_num());
+    EXPECT_EQ(directed_graph.edges().begin(), directed_graph.edges().end());
+    EXPECT_EQ(std::set<vertex_index_t>(), directed_graph.outbounds(23, 0));
+
+    std::vector<vertex_index_t> path;
+    EXPECT_FALSE(simple_graph::bfs(directed_graph, 2, [](char c) { return c == 'd'; }, &path));
+    directed_graph.add_edge(simple_graph::Edge<int, int>(2, 23, 0, 14));
+    EXPECT_EQ(1, directed_graph.edge_num());
+}
+
+TEST(ListGraphBatchTest, test_rm_vertices_same_as_rm_vertex)
+{
+    simple_graph::ListGraph<true, int, int, int> batch;
+    simple_graph::ListGraph<true, int, int, int> single;
+    for (int i = 0; i < 100; ++i) {
+        batch.add_vertex(simple_graph::Vertex<int>(i, i));
+        single.add_vertex(simple_graph::Vertex<int>(i, i));
+    }
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<> dist(0, 99);
+    for (int i = 0; i < 1000; ++i) {
+        simple_graph::Edge<int, int> edge(dist(gen), dist(gen), 0, i);
+        batch.add_edge(edge);
+        single.add_edge(edge);
+    }
+
+    std::vector<vertex_index_t> removed;
+    for (int i = 0; i < 100; i += 3) {
+        removed.push_back(i);
+        single.rm_vertex(i);
+    }
+    batch.rm_vertices(removed);
+
+    EXPECT_EQ(single.vertex_num(), batch.vertex_num());
+    ASSERT_EQ(single.edge_num(), batch.edge_num());
+    for (const auto &edge : single.edges()) {
+        EXPECT_EQ(edge.weight(), batch.edge(edge.idx1(), edge.idx2()).weight());
+    }
+    for (vertex_index_t idx = 0; idx < 100; ++idx) {
+        EXPECT_EQ(single.outbounds(idx, 1), batch.outbounds(idx, 1));
+        EXPECT_EQ(single.inbounds(idx), batch.inbounds(idx));
+    }
+}
+
 TEST_F(ListGraphDirectedTest, test_get_outbounds)
 {
     ASSERT_EQ(4, directed_graph.vertex_num());
@@ -307,6 +411,302 @@ TEST_F(ListGraphDirectedTest, test_filter_edge)
     }
 }
 
+TEST_F(ListGraphDirectedTest, test_neighbours)
+{
+    directed_graph.add_edge(simple_graph::Edge<int, int>(4, 23, 0, 14));
+    directed_graph.add_edge(simple_graph::Edge<int, int>(4, 2, 0, 11));
+    directed_graph.add_edge(simple_graph::Edge<int, int>(4, 6, 0, 12));
+    directed_graph.add_edge(simple_graph::Edge<int, int>(6, 4, 0, 13));
+
+    std::vector<std::pair<vertex_index_t, int>> neighbours;
+    for (const auto &n : directed_graph.out_neighbours(4, 0)) {
+        neighbours.emplace_back(n.idx, n.weight);
+    }
+    EXPECT_EQ((std::vector<std::pair<vertex_index_t, int>>{{2, 11}, {6, 12}, {23, 14}}), neighbours);
+
+    ASSERT_TRUE(directed_graph.filter_edge(simple_graph::Edge<int, int>(4, 6, 0)));
+
+    neighbours.clear();
+    for (const auto &n : directed_graph.out_neighbours(4, 0)) {
+        neighbours.emplace_back(n.idx, n.weight);
+    }
+    EXPECT_EQ((std::vector<std::pair<vertex_index_t, int>>{{2, 11}, {23, 14}}), neighbours);
+
+    int neighbours_num = 0;
+    for (const auto &n : directed_graph.out_neighbours(4, 1)) {
+        (void) n;
+        ++neighbours_num;
+    }
+    EXPECT_EQ(3, neighbours_num);
+    EXPECT_TRUE(directed_graph.in_neighbours(6).empty());
+    EXPECT_FALSE(directed_graph.in_neighbours(4).empty());
+
+    directed_graph.restore_edges();
+    EXPECT_EQ(3, directed_graph.outbounds(4, 0).size());
+    EXPECT_EQ(1, directed_graph.inbounds(6).size());
+    EXPECT_TRUE(directed_graph.out_neighbours(100, 0).empty());
+}
+
+TEST_F(ListGraphDirectedTest, test_edge_storage)
+{
+    directed_graph.add_edge(simple_graph::Edge<int, int>(2, 4, 0, 11));
+    directed_graph.add_edge(simple_graph::Edge<int, int>(4, 6, 0, 12));
+    directed_graph.add_edge(simple_graph::Edge<int, int>(6, 23, 0, 13));
+    directed_graph.add_edge(simple_graph::Edge<int, int>(23, 2, 0, 14));
+    ASSERT_EQ(4, directed_graph.edge_num());
+
+    auto edge_weights = [this]() {
+        std::map<std::pair<vertex_index_t, vertex_index_t>, int> res;
+        for (const auto &edge : directed_graph.edges()) {
+            res[{edge.idx1(), edge.idx2()}] = edge.weight();
+        }
+        return res;
+    };
+
+    /// Removed edge is replaced by the last one, all remaining edges stay reachable.
+    directed_graph.rm_edge(simple_graph::Edge<int, int>(2, 4, 0));
+    ASSERT_EQ(3, directed_graph.edge_num());
+    EXPECT_EQ(14, directed_graph.edge(23, 2).weight());
+    EXPECT_THROW(directed_graph.edge(2, 4), std::out_of_range);
+    EXPECT_EQ((std::map<std::pair<vertex_index_t, vertex_index_t>, int>{{{4, 6}, 12}, {{6, 23}, 13}, {{23, 2}, 14}}),
+            edge_weights());
+
+    /// Filter of the moved edge moves with it.
+    ASSERT_TRUE(directed_graph.filter_edge(simple_graph::Edge<int, int>(23, 2, 0)));
+    directed_graph.rm_edge(simple_graph::Edge<int, int>(4, 6, 0));
+    EXPECT_EQ((std::map<std::pair<vertex_index_t, vertex_index_t>, int>{{{6, 23}, 13}}), edge_weights());
+
+    /// Filter of absent edge applies once the edge is added.
+    EXPECT_FALSE(directed_graph.filter_edge(simple_graph::Edge<int, int>(2, 6, 0)));
+    directed_graph.add_edge(simple_graph::Edge<int, int>(2, 6, 0, 15));
+    EXPECT_EQ((std::map<std::pair<vertex_index_t, vertex_index_t>, int>{{{6, 23}, 13}}), edge_weights());
+    EXPECT_TRUE(directed_graph.out_neighbours(2, 0).empty());
+
+    directed_graph.restore_edges();
+    EXPECT_EQ((std::map<std::pair<vertex_index_t, vertex_index_t>, int>{{{2, 6}, 15}, {{6, 23}, 13}, {{23, 2}, 14}}),
+            edge_weights());
+    EXPECT_FALSE(directed_graph.out_neighbours(2, 0).empty());
+}
+
+TEST_F(ListGraphDirectedTest, test_edge_layout)
+{
+    /// Edges and vertices are stored without vtable pointer.
+    EXPECT_EQ(2 * sizeof(vertex_index_t) + sizeof(int) + sizeof(float), sizeof(simple_graph::Edge<int, float>));
+    EXPECT_EQ(sizeof(std::pair<vertex_index_t, int>), sizeof(simple_graph::Vertex<int>));
+
+    directed_graph.add_edge(simple_graph::Edge<int, int>(2, 4, 7, 11));
+    auto edge = directed_graph.edge(2, 4);
+    EXPECT_EQ(7, edge.parameters());
+    EXPECT_EQ(11, edge.weight());
+
+    simple_graph::Edge<int, int> copy = edge;
+    EXPECT_EQ(2, copy.idx1());
+    EXPECT_EQ(4, copy.idx2());
+    EXPECT_EQ(7, copy.parameters());
+}
+
+TEST_F(ListGraphDirectedTest, test_add_edges)
+{
+    directed_graph.add_edge(simple_graph::Edge<int, int>(2, 4, 0, 1));
+    directed_graph.filter_edge(simple_graph::Edge<int, int>(6, 23, 0));
+
+    directed_graph.add_edges({
+        simple_graph::Edge<int, int>(6, 23, 0, 5),
+        simple_graph::Edge<int, int>(2, 4, 0, 7),
+        simple_graph::Edge<int, int>(4, 2, 0, 3),
+        simple_graph::Edge<int, int>(2, 6, 0, 4),
+        simple_graph::Edge<int, int>(4, 2, 0, 9),
+        simple_graph::Edge<int, int>(23, 23, 0, 6),
+    });
+
+    EXPECT_EQ(5, directed_graph.edge_num());
+    /// First of duplicates wins, existing edge is kept.
+    EXPECT_EQ(1, directed_graph.edge(2, 4).weight());
+    EXPECT_EQ(3, directed_graph.edge(4, 2).weight());
+    EXPECT_EQ(std::set<vertex_index_t>({4, 6}), directed_graph.outbounds(2, 0));
+    EXPECT_EQ(std::set<vertex_index_t>({2}), directed_graph.inbounds(4));
+    EXPECT_EQ(std::set<vertex_index_t>({23}), directed_graph.inbounds(23));
+    /// Filter set before the edge was added applies to it.
+    EXPECT_EQ(std::set<vertex_index_t>({23}), directed_graph.outbounds(23, 0));
+    EXPECT_EQ(std::set<vertex_index_t>({23}), directed_graph.outbounds(6, 1));
+    EXPECT_TRUE(directed_graph.restore_edge(simple_graph::Edge<int, int>(6, 23, 0)));
+    EXPECT_EQ(std::set<vertex_index_t>({23}), directed_graph.outbounds(6, 0));
+
+    /// New edges are stored in batch order.
+    std::vector<std::pair<vertex_index_t, vertex_index_t>> order;
+    for (const auto &edge : directed_graph.edges()) {
+        order.emplace_back(edge.idx1(), edge.idx2());
+    }
+    EXPECT_EQ((std::vector<std::pair<vertex_index_t, vertex_index_t>>({{2, 4}, {6, 23}, {4, 2}, {2, 6}, {23, 23}})),
+            order);
+
+    EXPECT_THROW(directed_graph.add_edges({simple_graph::Edge<int, int>(4, 6, 0), simple_graph::Edge<int, int>(4, 5, 0)}),
+            std::out_of_range);
+    EXPECT_EQ(5, directed_graph.edge_num());
+    EXPECT_FALSE(directed_graph.edge_exists(simple_graph::Edge<int, int>(4, 6, 0)));
+}
+
+TEST(ListGraphBatchTest, test_same_as_add_edge)
+{
+    simple_graph::ListGraph<true, int, int, int> batch;
+    simple_graph::ListGraph<true, int, int, int> single;
+    for (int i = 0; i < 200; ++i) {
+        batch.add_vertex(simple_graph::Vertex<int>(i, i));
+        single.add_vertex(simple_graph::Vertex<int>(i, i));
+    }
+
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<> dist(0, 199);
+    for (int round = 0; round < 3; ++round) {
+        std::vector<simple_graph::Edge<int, int>> edges;
+        for (int i = 0; i < 2000; ++i) {
+            edges.emplace_back(dist(gen), dist(gen), 0, dist(gen));
+        }
+        for (const auto &edge : edges) {
+            single.add_edge(edge);
+        }
+        batch.add_edges(edges);
+    }
+
+    ASSERT_EQ(single.edge_num(), batch.edge_num());
+    for (vertex_index_t idx = 0; idx < 200; ++idx) {
+        std::vector<std::pair<vertex_index_t, int>> expected;
+        for (const auto &n : single.out_neighbours(idx, 0)) {
+            expected.emplace_back(n.idx, n.weight);
+        }
+        std::vector<std::pair<vertex_index_t, int>> actual;
+        for (const auto &n : batch.out_neighbours(idx, 0)) {
+            actual.emplace_back(n.idx, n.weight);
+        }
+        EXPECT_EQ(expected, actual);
+        EXPECT_EQ(single.inbounds(idx), batch.inbounds(idx));
+    }
+
+    auto it = batch.edges().begin();
+    for (const auto &edge : single.edges()) {
+        EXPECT_EQ(edge.idx1(), (*it).idx1());
+        EXPECT_EQ(edge.idx2(), (*it).idx2());
+        EXPECT_EQ(edge.weight(), (*it).weight());
+        ++it;
+    }
+}
+
+TEST(ListGraphEmplaceTest, test_emplace)
+{
+    simple_graph::ListGraph<true, std::string, std::pair<int, std::string>, int> g;
+    g.emplace_vertex(1, 3, 'a');
+    g.emplace_vertex(2, "b");
+    g.emplace_vertex(2, "c");
+    EXPECT_EQ(2, g.vertex_num());
+    EXPECT_EQ("aaa", g.vertex(1).data());
+    EXPECT_EQ("b", g.vertex(2).data());
+
+    g.emplace_edge(1, 2, 5, 7, "x");
+    g.emplace_edge(1, 2, 6, 8, "y");
+    EXPECT_EQ(1, g.edge_num());
+    EXPECT_EQ(5, g.edge(1, 2).weight());
+    EXPECT_EQ(std::make_pair(7, std::string("x")), g.edge(1, 2).parameters());
+    EXPECT_THROW(g.emplace_edge(1, 3, 0, 0, ""), std::out_of_range);
+
+    /// Payload is moved into the graph.
+    simple_graph::Edge<std::pair<int, std::string>, int> edge(2, 1, {9, std::string(100, 'z')}, 0);
+    g.add_edge(std::move(edge));
+    EXPECT_EQ(std::string(100, 'z'), g.edge(2, 1).parameters().second);
+    EXPECT_TRUE(edge.parameters().second.empty());
+}
+
+/**
+ * Check that graph storage is allocated from the arena only, default resource fails every allocation.
+ */
+template<bool Dense>
+void check_arena()
+{
+    std::pmr::monotonic_buffer_resource arena;
+    std::pmr::memory_resource *default_resource = std::pmr::set_default_resource(std::pmr::null_memory_resource());
+
+    {
+        simple_graph::ListGraph<true, int, int, int, Dense> g(&arena);
+        for (int i = 0; i < 100; ++i) {
+            g.add_vertex(simple_graph::Vertex<int>(i, i));
+        }
+        /// High degree vertices spill adjacency out of inline storage.
+        for (int i = 0; i < 100; ++i) {
+            for (int j = 1; j < 10; ++j) {
+                g.add_edge(simple_graph::Edge<int, int>(i, (i + j) % 100, 0, j));
+            }
+        }
+        g.filter_edge(simple_graph::Edge<int, int>(0, 1, 0));
+        g.filter_edge(simple_graph::Edge<int, int>(0, 50, 0));
+        g.rm_edge(simple_graph::Edge<int, int>(0, 2, 0));
+        g.rm_vertex(99);
+        g.restore_edges();
+
+        EXPECT_EQ(99, g.vertex_num());
+        EXPECT_EQ(100 * 9 - 1 - 2 * 9, g.edge_num());
+        EXPECT_EQ(3, g.edge(5, 8).weight());
+    }
+
+    std::pmr::set_default_resource(default_resource);
+}
+
+TEST(ListGraphArenaTest, test_sparse)
+{
+    check_arena<false>();
+}
+
+TEST(ListGraphArenaTest, test_dense)
+{
+    check_arena<true>();
+}
+
+/// Memory resource counting allocations passed to the default one.
+class CountingResource : public std::pmr::memory_resource {
+public:
+    size_t allocations() const { return allocations_; }
+
+private:
+    void *do_allocate(size_t bytes, size_t alignment) override
+    {
+        ++allocations_;
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void *p, size_t bytes, size_t alignment) override
+    {
+        std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override
+    {
+        return this == &other;
+    }
+
+    size_t allocations_ = 0;
+};
+
+TEST(ListGraphArenaTest, test_no_churn_at_inline_capacity)
+{
+    CountingResource resource;
+    simple_graph::ListGraph<true, int, int, int> g(&resource);
+    for (int i = 0; i < 6; ++i) {
+        g.add_vertex(simple_graph::Vertex<int>(i, i));
+    }
+    for (int i = 1; i < 5; ++i) {
+        g.add_edge(simple_graph::Edge<int, int>(0, i, 0, i));
+    }
+    g.add_edge(simple_graph::Edge<int, int>(0, 5, 0, 5));
+    g.rm_edge(simple_graph::Edge<int, int>(0, 5, 0));
+
+    /// Adjacency of vertex 0 keeps its heap block while one neighbour goes over inline capacity and back.
+    size_t allocations = resource.allocations();
+    for (int k = 0; k < 100; ++k) {
+        g.add_edge(simple_graph::Edge<int, int>(0, 5, 0, 5));
+        g.rm_edge(simple_graph::Edge<int, int>(0, 5, 0));
+    }
+    EXPECT_EQ(allocations, resource.allocations());
+    EXPECT_EQ(4, g.edge_num());
+}
+
 }  // namespace
 
 int main(int argc, char **argv)
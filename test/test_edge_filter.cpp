@@ -0,0 +1,208 @@
+#include <cstdlib>
+#include <limits>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+#include "simple_graph/edge_filter.hpp"
+#include "simple_graph/list_graph.hpp"
+#include "simple_graph/csr_graph.hpp"
+#include "simple_graph/algorithm/astar.hpp"
+#include "simple_graph/algorithm/bellman_ford.hpp"
+#include "simple_graph/algorithm/bfs.hpp"
+#include "simple_graph/algorithm/dijkstra.hpp"
+
+namespace {
+
+using simple_graph::vertex_index_t;
+
+/// Grid of n * n vertices with edges to the right and down neighbours.
+template<bool Dir>
+simple_graph::ListGraph<Dir, int, int, int> make_grid(int n)
+{
+    simple_graph::ListGraph<Dir, int, int, int> g;
+    for (int i = 0; i < n * n; ++i) {
+        g.add_vertex(simple_graph::Vertex<int>(i, i));
+    }
+    for (int r = 0; r < n; ++r) {
+        for (int c = 0; c < n; ++c) {
+            if (c + 1 < n) {
+                g.add_edge(simple_graph::Edge<int, int>(r * n + c, r * n + c + 1, 0, 1));
+            }
+            if (r + 1 < n) {
+                g.add_edge(simple_graph::Edge<int, int>(r * n + c, (r + 1) * n + c, 0, 1));
+            }
+        }
+    }
+    return g;
+}
+
+TEST(EdgeFilterTest, test_block)
+{
+    simple_graph::EdgeFilter directed(true);
+    EXPECT_TRUE(directed.empty());
+    directed.block(1, 2);
+    directed.block(1, 2);
+    EXPECT_EQ(1, directed.size());
+    EXPECT_TRUE(directed.blocks(1, 2));
+    EXPECT_FALSE(directed.blocks(2, 1));
+    EXPECT_TRUE(directed.touches(2));
+    EXPECT_FALSE(directed.touches(3));
+    EXPECT_FALSE(directed.blocks(100, 1));
+    EXPECT_THROW(directed.block(-1, 2), std::out_of_range);
+
+    directed.unblock(1, 2);
+    EXPECT_FALSE(directed.blocks(1, 2));
+    EXPECT_TRUE(directed.empty());
+
+    simple_graph::EdgeFilter undirected(false);
+    undirected.block(5, 3);
+    EXPECT_TRUE(undirected.blocks(3, 5));
+    EXPECT_TRUE(undirected.blocks(5, 3));
+    undirected.clear();
+    EXPECT_FALSE(undirected.blocks(3, 5));
+    EXPECT_FALSE(undirected.touches(5));
+}
+
+TEST(EdgeFilterTest, test_neighbours)
+{
+    auto g = make_grid<true>(3);
+    simple_graph::EdgeFilter filter(g);
+    filter.block(4, 5);
+    auto view = simple_graph::filtered(g, filter);
+
+    std::vector<vertex_index_t> out;
+    for (const auto &n : view.out_neighbours(4, 0)) {
+        out.push_back(n.idx);
+    }
+    EXPECT_EQ(std::vector<vertex_index_t>({7}), out);
+
+    std::vector<vertex_index_t> in;
+    for (const auto &n : view.in_neighbours(5)) {
+        in.push_back(n.idx);
+    }
+    EXPECT_EQ(std::vector<vertex_index_t>({2}), in);
+
+    /// Graph itself is intact.
+    EXPECT_EQ(2, g.outbounds(4, 0).size());
+    EXPECT_EQ(4, view.vertex(4).data());
+    EXPECT_EQ(9, view.vertex_num());
+}
+
+TEST(EdgeFilterTest, test_same_as_graph_filter)
+{
+    auto g = make_grid<false>(5);
+    auto filtered_g = g;
+    simple_graph::EdgeFilter filter(g);
+    for (auto e : std::vector<std::pair<int, int>>({{1, 0}, {5, 6}, {11, 12}, {13, 18}, {23, 22}})) {
+        filter.block(e.first, e.second);
+        filtered_g.filter_edge(simple_graph::Edge<int, int>(e.first, e.second, 0));
+    }
+    auto view = simple_graph::filtered(g, filter);
+
+    std::vector<vertex_index_t> expected;
+    std::vector<vertex_index_t> actual;
+    ASSERT_TRUE(simple_graph::bellman_ford(filtered_g, 0, 24, &expected));
+    ASSERT_TRUE(simple_graph::bellman_ford(view, 0, 24, &actual));
+    EXPECT_EQ(expected, actual);
+    EXPECT_EQ(9, actual.size());
+
+    std::vector<int> expected_distance;
+    std::vector<int> actual_distance;
+    std::vector<vertex_index_t> predecessor;
+    ASSERT_TRUE(simple_graph::dijkstra(filtered_g, 0, &expected_distance, &predecessor));
+    ASSERT_TRUE(simple_graph::dijkstra(view, 0, &actual_distance, &predecessor));
+    EXPECT_EQ(expected_distance, actual_distance);
+    EXPECT_EQ(4, actual_distance[6]);
+
+    expected.clear();
+    actual.clear();
+    auto is_last = simple_graph::by_index([](vertex_index_t idx) { return idx == 24; });
+    ASSERT_TRUE(simple_graph::bfs(filtered_g, 0, is_last, &expected));
+    ASSERT_TRUE(simple_graph::bfs(view, 0, is_last, &actual));
+    EXPECT_EQ(expected.size(), actual.size());
+}
+
+TEST(EdgeFilterTest, test_astar)
+{
+    auto g = make_grid<true>(4);
+    simple_graph::EdgeFilter filter(g);
+    auto heuristic = [](vertex_index_t c, vertex_index_t r) {
+        return static_cast<float>(std::abs(c / 4 - r / 4) + std::abs(c % 4 - r % 4));
+    };
+
+    /// Only edges between the first two columns are cut, so the path goes down the first column.
+    for (int r = 0; r < 3; ++r) {
+        filter.block(r * 4, r * 4 + 1);
+    }
+    std::vector<vertex_index_t> path;
+    ASSERT_TRUE(simple_graph::astar(simple_graph::filtered(g, filter), 0, 15, heuristic, &path));
+    EXPECT_EQ(std::vector<vertex_index_t>({0, 4, 8, 12, 13, 14, 15}), path);
+
+    filter.block(12, 13);
+    path.clear();
+    EXPECT_FALSE(simple_graph::astar(simple_graph::filtered(g, filter), 0, 15, heuristic, &path));
+
+    /// Graph itself keeps all paths.
+    path.clear();
+    ASSERT_TRUE(simple_graph::astar(g, 0, 15, heuristic, &path));
+    EXPECT_EQ(7, path.size());
+    EXPECT_EQ(1, path[1]);
+}
+
+TEST(EdgeFilterTest, test_csr)
+{
+    auto list = make_grid<true>(3);
+    simple_graph::CsrGraph<true, int, int, int> g(list);
+    simple_graph::EdgeFilter filter(g);
+    filter.block(0, 1);
+
+    std::vector<int> distance;
+    std::vector<vertex_index_t> predecessor;
+    ASSERT_TRUE(simple_graph::dijkstra(simple_graph::filtered(g, filter), 0, &distance, &predecessor));
+    EXPECT_EQ(std::numeric_limits<int>::max(), distance[1]);
+    EXPECT_EQ(std::numeric_limits<int>::max(), distance[2]);
+    EXPECT_EQ(2, distance[4]);
+    EXPECT_EQ(3, predecessor[4]);
+}
+
+TEST(EdgeFilterTest, test_concurrent_queries)
+{
+    const int n = 20;
+    const auto g = make_grid<false>(n);
+
+    /// Every thread blocks a different row of vertical edges, so only detours through other columns remain.
+    const int threads = 4;
+    std::vector<int> distance(threads, 0);
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&g, &distance, n, t] {
+            simple_graph::EdgeFilter filter(g);
+            int row = 2 + t;
+            for (int c = 0; c + 1 < n; ++c) {
+                filter.block(row * n + c, (row + 1) * n + c);
+            }
+            std::vector<int> d;
+            std::vector<vertex_index_t> predecessor;
+            for (int i = 0; i < 20; ++i) {
+                simple_graph::dijkstra(simple_graph::filtered(g, filter), 0, &d, &predecessor);
+            }
+            distance[t] = d[(n - 1) * n];
+        });
+    }
+    for (auto &w : workers) {
+        w.join();
+    }
+
+    for (int t = 0; t < threads; ++t) {
+        EXPECT_EQ(n - 1 + 2 * (n - 1), distance[t]);
+    }
+    EXPECT_EQ(0, g.vertex(0).data());
+}
+
+}  // namespace
+
+int main(int argc, char **argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
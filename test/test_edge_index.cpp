@@ -0,0 +1,82 @@
+#include <map>
+#include <random>
+#include <utility>
+#include <gtest/gtest.h>
+#include "simple_graph/edge_index.hpp"
+
+namespace {
+
+TEST(EdgeIndexTest, test_assign_find_erase)
+{
+    simple_graph::EdgeIndex index;
+    EXPECT_EQ(simple_graph::EdgeIndex::npos, index.find(0, 1));
+    EXPECT_FALSE(index.erase(0, 1));
+
+    index.assign(0, 1, 10);
+    index.assign(1, 0, 11);
+    EXPECT_EQ(2, index.size());
+    EXPECT_EQ(10, index.find(0, 1));
+    EXPECT_EQ(11, index.find(1, 0));
+
+    index.assign(0, 1, 12);
+    EXPECT_EQ(2, index.size());
+    EXPECT_EQ(12, index.find(0, 1));
+
+    EXPECT_TRUE(index.erase(0, 1));
+    EXPECT_FALSE(index.erase(0, 1));
+    EXPECT_EQ(simple_graph::EdgeIndex::npos, index.find(0, 1));
+    EXPECT_EQ(11, index.find(1, 0));
+    EXPECT_EQ(1, index.size());
+
+    index.clear();
+    EXPECT_TRUE(index.empty());
+    EXPECT_EQ(simple_graph::EdgeIndex::npos, index.find(1, 0));
+}
+
+TEST(EdgeIndexTest, test_insert)
+{
+    simple_graph::EdgeIndex index;
+    for (simple_graph::vertex_index_t i = 0; i < 1000; ++i) {
+        index.insert(i, i + 1, static_cast<size_t>(i));
+    }
+    EXPECT_EQ(1000, index.size());
+    EXPECT_EQ(500, index.find(500, 501));
+    EXPECT_EQ(simple_graph::EdgeIndex::npos, index.find(501, 500));
+}
+
+TEST(EdgeIndexTest, test_same_as_map)
+{
+    simple_graph::EdgeIndex index;
+    std::map<std::pair<simple_graph::vertex_index_t, simple_graph::vertex_index_t>, size_t> expected;
+
+    /// Many insertions and removals of a small set of keys leave deleted slots all over the table.
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<simple_graph::vertex_index_t> dist(0, 40);
+    for (size_t i = 0; i < 100000; ++i) {
+        simple_graph::vertex_index_t idx1 = dist(gen);
+        simple_graph::vertex_index_t idx2 = dist(gen);
+        if (gen() % 3 == 0) {
+            EXPECT_EQ(expected.erase({idx1, idx2}) == 1, index.erase(idx1, idx2));
+        }
+        else {
+            expected[{idx1, idx2}] = i;
+            index.assign(idx1, idx2, i);
+        }
+    }
+
+    EXPECT_EQ(expected.size(), index.size());
+    for (simple_graph::vertex_index_t idx1 = 0; idx1 <= 40; ++idx1) {
+        for (simple_graph::vertex_index_t idx2 = 0; idx2 <= 40; ++idx2) {
+            auto it = expected.find({idx1, idx2});
+            EXPECT_EQ(it == expected.end() ? simple_graph::EdgeIndex::npos : it->second, index.find(idx1, idx2));
+        }
+    }
+}
+
+}  // namespace
+
+int main(int argc, char **argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,125 @@
+#include <cstdlib>
+#include <vector>
+#include <gtest/gtest.h>
+#include "simple_graph/list_graph.hpp"
+#include "simple_graph/csr_graph.hpp"
+#include "simple_graph/graph_traits.hpp"
+#include "simple_graph/algorithm/astar.hpp"
+#include "simple_graph/algorithm/bellman_ford.hpp"
+#include "simple_graph/algorithm/bfs.hpp"
+#include "simple_graph/algorithm/dijkstra.hpp"
+
+namespace {
+
+using simple_graph::vertex_index_t;
+
+/**
+ * Path graph 0 - 1 - ... - (size - 1) which doesn't derive from Graph.
+ */
+class PathGraph {
+public:
+    static constexpr bool directed = false;
+    using vertex_type = int;
+    using edge_params_type = int;
+    using weight_type = int;
+
+    explicit PathGraph(int size)
+    {
+        for (int i = 0; i < size; ++i) {
+            vertices_.emplace_back(i, i * 10);
+        }
+        for (int i = 0; i < size; ++i) {
+            offsets_.push_back(targets_.size());
+            if (i > 0) {
+                targets_.push_back(i - 1);
+            }
+            if (i < size - 1) {
+                targets_.push_back(i + 1);
+            }
+        }
+        offsets_.push_back(targets_.size());
+        weights_.assign(targets_.size(), 2);
+    }
+
+    size_t vertex_num() const { return vertices_.size(); }
+
+    const simple_graph::Vertex<int> &vertex(vertex_index_t idx) const { return vertices_[idx]; }
+
+    simple_graph::NeighbourRange<int> out_neighbours(vertex_index_t idx, int) const
+    {
+        return simple_graph::NeighbourRange<int>(targets_.data() + offsets_[idx], weights_.data() + offsets_[idx],
+                nullptr, offsets_[idx + 1] - offsets_[idx]);
+    }
+
+private:
+    std::vector<simple_graph::Vertex<int>> vertices_;
+    std::vector<size_t> offsets_;
+    std::vector<vertex_index_t> targets_;
+    std::vector<int> weights_;
+};
+
+static_assert(simple_graph::is_graph_v<PathGraph>, "Standalone graph must satisfy the graph interface");
+static_assert(simple_graph::is_graph_v<simple_graph::ListGraph<true, int, int, float>>, "");
+static_assert(simple_graph::is_graph_v<simple_graph::CsrGraph<false, int, int, int>>, "");
+static_assert(simple_graph::is_graph_v<simple_graph::Graph<true, int, int, float>>, "");
+static_assert(!simple_graph::is_graph_v<int>, "");
+static_assert(!simple_graph::is_graph_v<std::vector<int>>, "");
+static_assert(std::is_same<simple_graph::graph_weight_t<simple_graph::ListGraph<true, char, int, double>>,
+        double>::value, "");
+static_assert(!simple_graph::graph_traits<PathGraph>::directed, "");
+
+TEST(GraphTraitsTest, test_standalone_graph)
+{
+    PathGraph g(10);
+
+    std::vector<vertex_index_t> path;
+    ASSERT_TRUE(simple_graph::bfs(g, 2, [](int data) { return data == 50; }, &path));
+    EXPECT_EQ(std::vector<vertex_index_t>({2, 3, 4, 5}), path);
+
+    std::vector<int> distance;
+    std::vector<vertex_index_t> predecessor;
+    ASSERT_TRUE(simple_graph::dijkstra(g, 0, &distance, &predecessor));
+    EXPECT_EQ(18, distance[9]);
+    EXPECT_EQ(8, predecessor[9]);
+
+    path.clear();
+    auto heuristic = [](vertex_index_t c, vertex_index_t r) { return 2.0f * std::abs(c - r); };
+    ASSERT_TRUE(simple_graph::astar(g, 9, 6, heuristic, &path));
+    EXPECT_EQ(std::vector<vertex_index_t>({9, 8, 7, 6}), path);
+
+    path.clear();
+    ASSERT_TRUE(simple_graph::bellman_ford(g, 3, 0, &path));
+    EXPECT_EQ(std::vector<vertex_index_t>({3, 2, 1, 0}), path);
+}
+
+TEST(GraphTraitsTest, test_type_erased_graph)
+{
+    simple_graph::ListGraph<true, int, int, int> lg;
+    for (int i = 0; i < 4; ++i) {
+        lg.add_vertex(simple_graph::Vertex<int>(i, i));
+    }
+    lg.add_edge(simple_graph::Edge<int, int>(0, 1, 0, 1));
+    lg.add_edge(simple_graph::Edge<int, int>(1, 2, 0, 1));
+    lg.add_edge(simple_graph::Edge<int, int>(0, 2, 0, 5));
+    auto cg = simple_graph::freeze(lg);
+
+    /// Algorithms accept the Graph interface when the concrete type is known only at runtime.
+    std::vector<const simple_graph::Graph<true, int, int, int>*> graphs = {&lg, &cg};
+    for (const auto *g : graphs) {
+        std::vector<vertex_index_t> path;
+        ASSERT_TRUE(simple_graph::bellman_ford(*g, 0, 2, &path));
+        EXPECT_EQ(std::vector<vertex_index_t>({0, 1, 2}), path);
+
+        path.clear();
+        ASSERT_TRUE(simple_graph::dijkstra(*g, 0, [](int data) { return data == 2; }, &path));
+        EXPECT_EQ(std::vector<vertex_index_t>({0, 1, 2}), path);
+    }
+}
+
+}  // namespace
+
+int main(int argc, char **argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
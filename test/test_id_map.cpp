@@ -0,0 +1,60 @@
+#include <string>
+#include <gtest/gtest.h>
+#include "simple_graph/id_map.hpp"
+#include "simple_graph/list_graph.hpp"
+#include "simple_graph/algorithm/bfs.hpp"
+
+namespace {
+
+using simple_graph::vertex_index_t;
+
+TEST(IdMapTest, test_insert_find)
+{
+    simple_graph::IdMap<std::string> ids;
+    EXPECT_EQ(0, ids.insert("b"));
+    EXPECT_EQ(1, ids.insert("a"));
+    EXPECT_EQ(0, ids.insert("b"));
+    EXPECT_EQ(2, ids.size());
+
+    EXPECT_EQ(1, ids.find("a"));
+    EXPECT_EQ(-1, ids.find("c"));
+    EXPECT_EQ("b", ids.key(0));
+    EXPECT_THROW(ids.key(2), std::out_of_range);
+}
+
+TEST(IdMapTest, test_sparse_ids)
+{
+    /// Sparse external identifiers are mapped to dense vertex indices before building the graph.
+    std::vector<std::pair<long, long>> edges = {{1000000, 7}, {7, 123456789}, {123456789, 42}, {1000000, 42}};
+
+    simple_graph::IdMap<long> ids;
+    simple_graph::ListGraph<false, long, int, int, true> g;
+    for (const auto &e : edges) {
+        for (long key : {e.first, e.second}) {
+            if (ids.find(key) == -1) {
+                vertex_index_t idx = ids.insert(key);
+                g.add_vertex(simple_graph::Vertex<long>(idx, key));
+            }
+        }
+        g.add_edge(simple_graph::Edge<int, int>(ids.find(e.first), ids.find(e.second), 0));
+    }
+    ASSERT_EQ(4, g.vertex_num());
+
+    std::vector<vertex_index_t> path;
+    ASSERT_TRUE(simple_graph::bfs(g, ids.find(7), [](long key) { return key == 42; }, &path));
+    std::vector<long> keys;
+    for (vertex_index_t idx : path) {
+        keys.push_back(ids.key(idx));
+    }
+    EXPECT_EQ(3, keys.size());
+    EXPECT_EQ(7, keys.front());
+    EXPECT_EQ(42, keys.back());
+}
+
+}  // namespace
+
+int main(int argc, char **argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,92 @@
+#include <algorithm>
+#include <random>
+#include <gtest/gtest.h>
+#include "simple_graph/indexed_heap.hpp"
+
+namespace {
+
+using simple_graph::vertex_index_t;
+
+template<typename Heap>
+class IndexedHeapTest : public ::testing::Test {};
+
+using Heaps = ::testing::Types<simple_graph::BinaryHeap<float>, simple_graph::QuaternaryHeap<float>,
+        simple_graph::IndexedHeap<float, 3>>;
+TYPED_TEST_SUITE(IndexedHeapTest, Heaps);
+
+TYPED_TEST(IndexedHeapTest, test_push_pop)
+{
+    TypeParam heap(8);
+    EXPECT_TRUE(heap.empty());
+
+    heap.push(3, 3.0f);
+    heap.push(1, 1.0f);
+    heap.push(7, 0.5f);
+    heap.push(5, 2.0f);
+
+    ASSERT_EQ(4, heap.size());
+    EXPECT_TRUE(heap.contains(5));
+    EXPECT_FALSE(heap.contains(0));
+    EXPECT_EQ(2.0f, heap.key(5));
+    EXPECT_EQ(7, heap.top());
+
+    EXPECT_EQ(7, heap.pop());
+    EXPECT_FALSE(heap.contains(7));
+    EXPECT_EQ(1, heap.pop());
+    EXPECT_EQ(5, heap.pop());
+    EXPECT_EQ(3, heap.pop());
+    EXPECT_TRUE(heap.empty());
+}
+
+TYPED_TEST(IndexedHeapTest, test_decrease)
+{
+    TypeParam heap(4);
+    heap.push(0, 10.0f);
+    heap.push(1, 20.0f);
+    heap.push(2, 30.0f);
+
+    heap.decrease(2, 5.0f);
+    EXPECT_EQ(5.0f, heap.key(2));
+    EXPECT_EQ(2, heap.pop());
+
+    heap.decrease(1, 10.0f);
+    heap.push(2, 1.0f);
+    EXPECT_EQ(2, heap.pop());
+    EXPECT_EQ(10.0f, heap.key(heap.top()));
+    heap.pop();
+    EXPECT_EQ(10.0f, heap.key(heap.top()));
+}
+
+TYPED_TEST(IndexedHeapTest, test_random)
+{
+    constexpr size_t size = 1000;
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<float> dist(0.0f, 100.0f);
+
+    TypeParam heap(size);
+    std::vector<float> keys(size);
+    for (size_t i = 0; i < size; ++i) {
+        keys[i] = dist(gen);
+        heap.push(i, keys[i]);
+    }
+    for (size_t i = 0; i < size; i += 3) {
+        keys[i] /= 2;
+        heap.decrease(i, keys[i]);
+    }
+
+    std::vector<float> popped;
+    while (!heap.empty()) {
+        popped.push_back(keys[heap.pop()]);
+    }
+
+    std::sort(keys.begin(), keys.end());
+    EXPECT_EQ(keys, popped);
+}
+
+}  // namespace
+
+int main(int argc, char **argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,141 @@
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+#include "simple_graph/list_graph.hpp"
+#include "simple_graph/algorithm/bfs.hpp"
+
+#if !defined(SIMPLE_GRAPH_INSTRUMENT)
+#error "Instrumentation test requires SIMPLE_GRAPH_INSTRUMENT"
+#endif
+
+SIMPLE_GRAPH_DEFINE_ALLOCATION_HOOKS
+
+namespace {
+
+using simple_graph::vertex_index_t;
+
+TEST(InstrumentTest, test_object_counters)
+{
+    using Vertex = simple_graph::Vertex<int>;
+    using Edge = simple_graph::Edge<int, int>;
+    Vertex::reset_counters();
+    Edge::reset_counters();
+
+    Vertex v(1, 2);
+    Vertex copy(v);
+    Vertex moved(std::move(copy));
+    copy = v;
+    Edge e(1, 2, 0);
+    Edge e_copy(e);
+
+    simple_graph::ObjectCounters vc = Vertex::counters();
+    EXPECT_EQ(1, vc.creations);
+    EXPECT_EQ(1, vc.copies);
+    EXPECT_EQ(1, vc.moves);
+    EXPECT_EQ(1, vc.assigns);
+    EXPECT_EQ(1, Edge::counters().creations);
+    EXPECT_EQ(1, Edge::counters().copies);
+
+    Vertex::reset_counters();
+    EXPECT_EQ(0, Vertex::counters().creations);
+}
+
+TEST(InstrumentTest, test_per_thread)
+{
+    using Vertex = simple_graph::Vertex<int>;
+    Vertex::reset_counters();
+
+    std::uint64_t other_copies = 0;
+    std::thread t([&other_copies] {
+        Vertex v(1, 2);
+        for (int i = 0; i < 10; ++i) {
+            Vertex copy(v);
+        }
+        other_copies = Vertex::counters().copies;
+    });
+    t.join();
+
+    EXPECT_EQ(10, other_copies);
+    EXPECT_EQ(0, Vertex::counters().copies);
+    EXPECT_EQ(0, Vertex::counters().creations);
+}
+
+TEST(InstrumentTest, test_zero_copies)
+{
+    using Vertex = simple_graph::Vertex<std::vector<int>>;
+    using Edge = simple_graph::Edge<std::vector<int>, int>;
+    simple_graph::ListGraph<false, std::vector<int>, std::vector<int>, int> g;
+    Vertex::reset_counters();
+    Edge::reset_counters();
+
+    for (int i = 0; i < 100; ++i) {
+        if (i % 2) {
+            g.add_vertex(Vertex(i, std::vector<int>(16, i)));
+        }
+        else {
+            g.emplace_vertex(i, 16, i);
+        }
+    }
+    for (int i = 0; i + 1 < 100; ++i) {
+        if (i % 2) {
+            g.add_edge(Edge(i, i + 1, std::vector<int>(16, i), 1));
+        }
+        else {
+            g.emplace_edge(i, i + 1, 1, 16, i);
+        }
+    }
+
+    /// Queries and accessors don't copy payloads either.
+    std::vector<vertex_index_t> path;
+    auto is_last = [](const std::vector<int> &data) { return data[0] == 99; };
+    ASSERT_TRUE(simple_graph::bfs(g, 0, is_last, &path));
+    EXPECT_EQ(100, path.size());
+    EXPECT_EQ(16, g.edge(5, 6).parameters().size());
+    EXPECT_EQ(16, g.vertex(5).data().size());
+
+    EXPECT_EQ(0, Vertex::counters().copies);
+    EXPECT_EQ(0, Vertex::counters().assigns);
+    EXPECT_EQ(0, Edge::counters().copies);
+    EXPECT_EQ(0, Edge::counters().assigns);
+}
+
+TEST(InstrumentTest, test_allocations)
+{
+    simple_graph::ListGraph<true, int, int, int> g;
+    for (int i = 0; i < 100; ++i) {
+        g.add_vertex(simple_graph::Vertex<int>(i, i));
+    }
+    for (int i = 0; i + 1 < 100; ++i) {
+        g.add_edge(simple_graph::Edge<int, int>(i, i + 1, 0));
+    }
+
+    simple_graph::TraversalContext context;
+    std::vector<vertex_index_t> path;
+    path.reserve(100);
+    auto is_last = simple_graph::by_index([](vertex_index_t idx) { return idx == 99; });
+
+    {
+        simple_graph::instrument::AllocationScope scope;
+        ASSERT_TRUE(simple_graph::bfs(g, 0, is_last, &path, &context));
+        EXPECT_LT(0, scope.counters().allocations);
+        EXPECT_LT(0, scope.counters().allocated_bytes);
+    }
+
+    /// Search state is reused, so repeated query doesn't allocate.
+    path.clear();
+    {
+        simple_graph::instrument::AllocationScope scope;
+        ASSERT_TRUE(simple_graph::bfs(g, 0, is_last, &path, &context));
+        EXPECT_EQ(0, scope.counters().allocations);
+        EXPECT_EQ(0, scope.counters().deallocations);
+    }
+    EXPECT_EQ(100, path.size());
+}
+
+}  // namespace
+
+int main(int argc, char **argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
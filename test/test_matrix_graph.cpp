@@ -0,0 +1,237 @@
+#include <algorithm>
+#include <functional>
+#include <random>
+#include <gtest/gtest.h>
+#include "simple_graph/list_graph.hpp"
+#include "simple_graph/matrix_graph.hpp"
+#include "simple_graph/algorithm/bfs.hpp"
+
+namespace {
+
+using simple_graph::vertex_index_t;
+
+class MatrixGraphTest : public ::testing::Test {
+protected:
+    virtual void SetUp() {
+        for (int i = 0; i < 6; ++i) {
+            directed_graph.add_vertex(simple_graph::Vertex<int>(i, i));
+            undirected_graph.add_vertex(simple_graph::Vertex<int>(i, i));
+        }
+
+        std::vector<std::tuple<int, int, int>> edges = {
+                {0, 1, 1}, {1, 2, 1}, {2, 3, 1}, {0, 4, 5}, {4, 3, 1}, {3, 5, 2}
+        };
+        for (const auto &e : edges) {
+            directed_graph.add_edge(simple_graph::Edge<int, int>(std::get<0>(e), std::get<1>(e), 0, std::get<2>(e)));
+            undirected_graph.add_edge(simple_graph::Edge<int, int>(std::get<1>(e), std::get<0>(e), 0, std::get<2>(e)));
+        }
+    }
+
+    simple_graph::MatrixGraph<true, int, int, int> directed_graph;
+    simple_graph::MatrixGraph<false, int, int, int> undirected_graph;
+};
+
+TEST_F(MatrixGraphTest, test_edges)
+{
+    ASSERT_EQ(6, directed_graph.vertex_num());
+    ASSERT_EQ(6, directed_graph.edge_num());
+    EXPECT_EQ(4, directed_graph.vertex(4).data());
+    EXPECT_EQ(5, directed_graph.edge(0, 4).weight());
+    EXPECT_EQ(std::set<vertex_index_t>({1, 4}), directed_graph.outbounds(0, 0));
+    EXPECT_EQ(std::set<vertex_index_t>({2, 4}), directed_graph.inbounds(3));
+
+    EXPECT_TRUE(directed_graph.edge_exists(simple_graph::Edge<int, int>(4, 3, 0)));
+    EXPECT_FALSE(directed_graph.edge_exists(simple_graph::Edge<int, int>(3, 4, 0)));
+    EXPECT_FALSE(directed_graph.edge_exists(simple_graph::Edge<int, int>(3, 100, 0)));
+    EXPECT_TRUE(undirected_graph.has_edge(4, 3));
+    EXPECT_TRUE(undirected_graph.has_edge(3, 4));
+
+    directed_graph.rm_edge(simple_graph::Edge<int, int>(4, 3, 0));
+    EXPECT_FALSE(directed_graph.has_edge(4, 3));
+    undirected_graph.rm_edge(simple_graph::Edge<int, int>(4, 3, 0));
+    EXPECT_FALSE(undirected_graph.has_edge(3, 4));
+
+    EXPECT_THROW(directed_graph.add_edge(simple_graph::Edge<int, int>(0, 6, 0)), std::out_of_range);
+}
+
+TEST_F(MatrixGraphTest, test_rm_vertex)
+{
+    undirected_graph.rm_vertex(3);
+    EXPECT_EQ(5, undirected_graph.vertex_num());
+    EXPECT_EQ(3, undirected_graph.edge_num());
+    for (vertex_index_t idx = 0; idx < 6; ++idx) {
+        EXPECT_FALSE(undirected_graph.has_edge(idx, 3));
+        EXPECT_FALSE(undirected_graph.has_edge(3, idx));
+    }
+    EXPECT_THROW(undirected_graph.rm_vertex(3), std::out_of_range);
+}
+
+TEST_F(MatrixGraphTest, test_common_neighbours)
+{
+    EXPECT_EQ(std::vector<vertex_index_t>({0}), undirected_graph.common_neighbours(1, 4));
+    EXPECT_EQ(1, undirected_graph.common_neighbour_num(1, 4));
+    EXPECT_EQ(std::vector<vertex_index_t>({2, 4, 5}), undirected_graph.common_neighbours(3, 3));
+    EXPECT_EQ(std::vector<vertex_index_t>(), directed_graph.common_neighbours(1, 4));
+    EXPECT_EQ(std::vector<vertex_index_t>({3}), directed_graph.common_neighbours(2, 4));
+}
+
+TEST_F(MatrixGraphTest, test_filter_edge)
+{
+    /// Filtered edge is hidden from adjacency lists but is still in the matrix.
+    EXPECT_TRUE(directed_graph.filter_edge(simple_graph::Edge<int, int>(0, 1, 0)));
+    EXPECT_EQ(std::set<vertex_index_t>({4}), directed_graph.outbounds(0, 0));
+    EXPECT_TRUE(directed_graph.has_edge(0, 1));
+    directed_graph.restore_edges();
+    EXPECT_EQ(std::set<vertex_index_t>({1, 4}), directed_graph.outbounds(0, 0));
+}
+
+TEST_F(MatrixGraphTest, test_bfs)
+{
+    std::vector<vertex_index_t> path;
+    EXPECT_TRUE(simple_graph::bfs(directed_graph, 0, [](int data) { return data == 5; }, &path));
+    EXPECT_EQ(std::vector<vertex_index_t>({0, 4, 3, 5}), path);
+
+    path.clear();
+    EXPECT_FALSE(simple_graph::bfs(directed_graph, 5, [](int data) { return data == 0; }, &path));
+    EXPECT_TRUE(path.empty());
+    EXPECT_FALSE(simple_graph::bfs(directed_graph, 6, [](int) { return true; }, &path));
+}
+
+TEST(MatrixGraphRandomTest, test_bfs_same_as_list)
+{
+    simple_graph::MatrixGraph<true, int, int, int> matrix;
+    simple_graph::ListGraph<true, int, int, int> list;
+
+    const int vnum = 200;
+    for (int i = 0; i < vnum; ++i) {
+        matrix.add_vertex(simple_graph::Vertex<int>(i, i));
+        list.add_vertex(simple_graph::Vertex<int>(i, i));
+    }
+
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<int> dist(0, vnum - 1);
+    for (int i = 0; i < vnum * 3; ++i) {
+        int u = dist(gen);
+        int v = dist(gen);
+        matrix.add_edge(simple_graph::Edge<int, int>(u, v, 0));
+        list.add_edge(simple_graph::Edge<int, int>(u, v, 0));
+    }
+
+    /// One context for all queries, frontiers left by a deeper search must not leak into the next one.
+    simple_graph::BitTraversalContext context;
+    for (int target = 1; target < vnum; ++target) {
+        std::vector<vertex_index_t> matrix_path;
+        std::vector<vertex_index_t> list_path;
+        auto pred = [target](int data) { return data == target; };
+        bool found = simple_graph::bfs(list, 0, pred, &list_path);
+        ASSERT_EQ(found, simple_graph::bfs(matrix, 0, pred, &matrix_path, &context));
+        ASSERT_EQ(list_path.size(), matrix_path.size());
+        if (found) {
+            EXPECT_EQ(0, matrix_path.front());
+            EXPECT_EQ(target, matrix_path.back());
+            for (size_t i = 1; i < matrix_path.size(); ++i) {
+                EXPECT_TRUE(matrix.has_edge(matrix_path[i - 1], matrix_path[i]));
+            }
+        }
+    }
+}
+
+template<bool Dir>
+void check_same_as_list()
+{
+    simple_graph::MatrixGraph<Dir, int, int, int> matrix;
+    simple_graph::ListGraph<Dir, int, int, int> list;
+
+    const int vnum = 70;
+    for (int i = 0; i < vnum; ++i) {
+        matrix.add_vertex(simple_graph::Vertex<int>(i, i));
+        list.add_vertex(simple_graph::Vertex<int>(i, i));
+    }
+
+    /// Random mix of modifications, both graphs must end up with the same edges and filters.
+    std::mt19937 gen(Dir ? 1 : 2);
+    std::uniform_int_distribution<int> vertex(0, vnum - 1);
+    std::uniform_int_distribution<int> action(0, 99);
+    std::vector<int> removed;
+    for (int i = 0; i < 4000; ++i) {
+        int u = vertex(gen);
+        int v = vertex(gen);
+        if (std::find(removed.begin(), removed.end(), u) != removed.end()
+                || std::find(removed.begin(), removed.end(), v) != removed.end()) {
+            continue;
+        }
+        simple_graph::Edge<int, int> edge(u, v, u * vnum + v, action(gen));
+        int a = action(gen);
+        if (a < 60) {
+            matrix.add_edge(edge);
+            list.add_edge(edge);
+        }
+        else if (a < 75) {
+            matrix.rm_edge(edge);
+            list.rm_edge(edge);
+        }
+        else if (a < 88) {
+            EXPECT_EQ(list.filter_edge(edge), matrix.filter_edge(edge));
+        }
+        else if (a < 98) {
+            EXPECT_EQ(list.restore_edge(edge), matrix.restore_edge(edge));
+        }
+        else if (removed.size() < 5) {
+            matrix.rm_vertex(u);
+            list.rm_vertex(u);
+            removed.push_back(u);
+        }
+    }
+
+    ASSERT_EQ(list.vertex_num(), matrix.vertex_num());
+    ASSERT_EQ(list.edge_num(), matrix.edge_num());
+    for (int u = 0; u < vnum; ++u) {
+        if (std::find(removed.begin(), removed.end(), u) != removed.end()) {
+            EXPECT_FALSE(matrix.out_neighbours(u, 1).begin() != matrix.out_neighbours(u, 1).end());
+            continue;
+        }
+        EXPECT_EQ(list.outbounds(u, 0), matrix.outbounds(u, 0));
+        EXPECT_EQ(list.outbounds(u, 1), matrix.outbounds(u, 1));
+        EXPECT_EQ(list.inbounds(u), matrix.inbounds(u));
+        for (const auto &n : matrix.out_neighbours(u, 1)) {
+            auto edge = matrix.edge(u, n.idx);
+            EXPECT_EQ(list.edge(u, n.idx).weight(), n.weight);
+            EXPECT_EQ(list.edge(u, n.idx).weight(), edge.weight());
+            EXPECT_EQ(list.edge(u, n.idx).parameters(), edge.parameters());
+            EXPECT_TRUE(matrix.has_edge(u, n.idx));
+        }
+        for (int v = 0; v < vnum; ++v) {
+            EXPECT_EQ(list.edge_exists(simple_graph::Edge<int, int>(u, v, 0)), matrix.has_edge(u, v));
+        }
+    }
+
+    std::set<std::pair<vertex_index_t, vertex_index_t>> list_edges;
+    std::set<std::pair<vertex_index_t, vertex_index_t>> matrix_edges;
+    for (const auto &e : list.edges()) {
+        list_edges.emplace(e.idx1(), e.idx2());
+    }
+    for (const auto &e : matrix.edges()) {
+        matrix_edges.emplace(e.idx1(), e.idx2());
+    }
+    EXPECT_EQ(list_edges, matrix_edges);
+
+    list.restore_edges();
+    matrix.restore_edges();
+    for (int u = 0; u < vnum; ++u) {
+        EXPECT_EQ(list.outbounds(u, 0), matrix.outbounds(u, 0));
+    }
+}
+
+TEST(MatrixGraphRandomTest, test_same_as_list)
+{
+    check_same_as_list<true>();
+    check_same_as_list<false>();
+}
+
+}  // namespace
+
+int main(int argc, char **argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
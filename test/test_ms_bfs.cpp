@@ -0,0 +1,132 @@
+#include <random>
+#include <vector>
+#include <gtest/gtest.h>
+#include "simple_graph/list_graph.hpp"
+#include "simple_graph/csr_graph.hpp"
+#include "simple_graph/algorithm/ms_bfs.hpp"
+#include "bfs_test_util.hpp"
+
+namespace {
+
+using simple_graph::vertex_index_t;
+using bfs_test_util::make_random;
+
+std::vector<vertex_index_t> random_sources(size_t num, int n, unsigned seed)
+{
+    std::mt19937 gen(seed);
+    std::uniform_int_distribution<vertex_index_t> vertex(0, n - 1);
+    std::vector<vertex_index_t> sources(num);
+    for (auto &s : sources) {
+        s = vertex(gen);
+    }
+    return sources;
+}
+
+template<size_t Words, typename G>
+void check_levels(const G &g, const std::vector<vertex_index_t> &sources)
+{
+    std::vector<std::vector<size_t>> level;
+    ASSERT_TRUE(simple_graph::ms_bfs_levels<Words>(g, sources, &level));
+    ASSERT_EQ(sources.size(), level.size());
+    for (size_t i = 0; i < sources.size(); ++i) {
+        EXPECT_EQ(bfs_test_util::reference_levels(g, sources[i], 1), level[i]) << "source " << sources[i];
+    }
+}
+
+TEST(SourceMaskTest, test_bits)
+{
+    simple_graph::SourceMask<4> mask;
+    EXPECT_FALSE(mask.any());
+    mask.set(3);
+    mask.set(64);
+    mask.set(255);
+    EXPECT_TRUE(mask.test(64));
+    EXPECT_FALSE(mask.test(65));
+    EXPECT_EQ(3, mask.count());
+
+    simple_graph::SourceMask<4> other;
+    other.set(64);
+    other.set(100);
+    mask |= other;
+    EXPECT_EQ(4, mask.count());
+    mask.remove(other);
+    std::vector<size_t> bits;
+    mask.for_each([&bits](size_t i) { bits.push_back(i); });
+    EXPECT_EQ(std::vector<size_t>({3, 255}), bits);
+    mask.clear();
+    EXPECT_FALSE(mask.any());
+}
+
+TEST(MsBfsTest, test_directed)
+{
+    auto g = make_random<true>(1500, 3, 1);
+    /// Partial last batch for both mask widths.
+    auto sources = random_sources(300, 1500, 2);
+    check_levels<1>(g, sources);
+    check_levels<4>(g, sources);
+}
+
+TEST(MsBfsTest, test_undirected)
+{
+    auto g = make_random<false>(1000, 2, 3);
+    auto sources = random_sources(100, 1000, 4);
+    check_levels<1>(g, sources);
+    check_levels<2>(g, sources);
+}
+
+TEST(MsBfsTest, test_csr)
+{
+    auto list = make_random<true>(800, 4, 5);
+    simple_graph::CsrGraph<true, int, int, int> g(list);
+    check_levels<4>(g, random_sources(256, 800, 6));
+}
+
+TEST(MsBfsTest, test_visitor)
+{
+    /// Path 0 -> 1 -> 2 -> 3.
+    simple_graph::ListGraph<true, int, int, int> g;
+    for (int i = 0; i < 4; ++i) {
+        g.add_vertex(simple_graph::Vertex<int>(i, i));
+    }
+    for (int i = 0; i + 1 < 4; ++i) {
+        g.add_edge(simple_graph::Edge<int, int>(i, i + 1, 0, 1));
+    }
+
+    std::vector<vertex_index_t> sources = {0, 2, 2};
+    std::vector<size_t> total(sources.size(), 0);
+    size_t calls = 0;
+    ASSERT_TRUE(simple_graph::ms_bfs(g, sources, [&](vertex_index_t v, size_t level,
+            const simple_graph::SourceMask<1> &mask) {
+        ++calls;
+        if (v == 2) {
+            EXPECT_EQ(level == 0 ? 2 : 1, mask.count());
+        }
+        mask.for_each([&total, level](size_t i) { total[i] += level; });
+    }));
+    EXPECT_EQ(std::vector<size_t>({1 + 2 + 3, 1, 1}), total);
+    /// Vertices 2 and 3 are visited twice: by sources 1 and 2 together, then later by source 0.
+    EXPECT_EQ(6, calls);
+}
+
+TEST(MsBfsTest, test_invalid_sources)
+{
+    auto g = make_random<true>(10, 2, 7);
+    auto nothing = [](vertex_index_t, size_t, const simple_graph::SourceMask<1> &) {};
+    EXPECT_FALSE(simple_graph::ms_bfs(g, {0, 10}, nothing));
+    EXPECT_FALSE(simple_graph::ms_bfs(g, {-1}, nothing));
+    EXPECT_FALSE(simple_graph::ms_bfs(g, std::vector<vertex_index_t>(65, 0), nothing));
+    EXPECT_TRUE(simple_graph::ms_bfs(g, std::vector<vertex_index_t>(64, 0), nothing));
+    EXPECT_TRUE(simple_graph::ms_bfs(g, {}, nothing));
+
+    std::vector<std::vector<size_t>> level;
+    EXPECT_TRUE(simple_graph::ms_bfs_levels(g, std::vector<vertex_index_t>(65, 3), &level));
+    EXPECT_FALSE(simple_graph::ms_bfs_levels(g, {3, 11}, &level));
+}
+
+}  // namespace
+
+int main(int argc, char **argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,130 @@
+#include <vector>
+#include <gtest/gtest.h>
+#include "simple_graph/list_graph.hpp"
+#include "simple_graph/csr_graph.hpp"
+#include "simple_graph/edge_filter.hpp"
+#include "simple_graph/algorithm/parallel_bfs.hpp"
+#include "bfs_test_util.hpp"
+
+namespace {
+
+using simple_graph::vertex_index_t;
+using bfs_test_util::make_random;
+using bfs_test_util::unreached;
+
+/// Check that levels are exact and every parent is one level up and has edge to its child.
+template<typename G>
+void check_bfs(const G &g, vertex_index_t start_idx, simple_graph::ThreadPool *pool)
+{
+    std::vector<size_t> level;
+    std::vector<vertex_index_t> parent;
+    ASSERT_TRUE(simple_graph::parallel_bfs(g, start_idx, &level, &parent, pool));
+    ASSERT_EQ(bfs_test_util::reference_levels(g, start_idx, 0), level);
+
+    ASSERT_EQ(level.size(), parent.size());
+    EXPECT_EQ(-1, parent[start_idx]);
+    for (size_t v = 0; v < level.size(); ++v) {
+        if ((level[v] == unreached) || (static_cast<vertex_index_t>(v) == start_idx)) {
+            EXPECT_EQ(-1, parent[v]);
+            continue;
+        }
+        vertex_index_t p = parent[v];
+        ASSERT_NE(-1, p);
+        EXPECT_EQ(level[v] - 1, level[p]);
+        bool has_edge = false;
+        for (const auto &n : g.out_neighbours(p, 0)) {
+            has_edge = has_edge || (n.idx == static_cast<vertex_index_t>(v));
+        }
+        EXPECT_TRUE(has_edge);
+    }
+}
+
+TEST(ParallelBfsTest, test_directed)
+{
+    auto g = make_random<true>(3000, 2, 1, 300);
+    for (size_t threads : {1, 2, 4}) {
+        simple_graph::ThreadPool pool(threads);
+        for (vertex_index_t start : {0, 1500, 2999}) {
+            check_bfs(g, start, &pool);
+        }
+    }
+}
+
+TEST(ParallelBfsTest, test_undirected)
+{
+    auto g = make_random<false>(3000, 2, 2, 100);
+    for (size_t threads : {1, 2, 4}) {
+        simple_graph::ThreadPool pool(threads);
+        for (vertex_index_t start : {0, 2000}) {
+            check_bfs(g, start, &pool);
+        }
+    }
+}
+
+TEST(ParallelBfsTest, test_csr)
+{
+    auto list = make_random<true>(2000, 2, 3, 500);
+    simple_graph::CsrGraph<true, int, int, int> g(list);
+    simple_graph::ThreadPool pool(4);
+    check_bfs(g, 7, &pool);
+}
+
+TEST(ParallelBfsTest, test_filtered)
+{
+    auto g = make_random<false>(1000, 2, 4, 1000);
+    simple_graph::EdgeFilter filter(g);
+    for (const auto &n : g.out_neighbours(0, 0)) {
+        filter.block(0, n.idx);
+    }
+    auto view = simple_graph::filtered(g, filter);
+
+    std::vector<size_t> level;
+    std::vector<vertex_index_t> parent;
+    ASSERT_TRUE(simple_graph::parallel_bfs(view, 0, &level, &parent));
+    EXPECT_EQ(0, level[0]);
+    for (size_t v = 1; v < level.size(); ++v) {
+        EXPECT_EQ(unreached, level[v]);
+    }
+
+    simple_graph::ThreadPool pool(2);
+    check_bfs(view, 1, &pool);
+}
+
+TEST(ParallelBfsTest, test_sparse_indices)
+{
+    /// Path 0 - 64 - 128 - ... with absent vertices between.
+    simple_graph::ListGraph<true, int, int, int> g;
+    for (int i = 0; i < 10; ++i) {
+        g.add_vertex(simple_graph::Vertex<int>(i * 64, i));
+    }
+    for (int i = 0; i + 1 < 10; ++i) {
+        g.add_edge(simple_graph::Edge<int, int>(i * 64, (i + 1) * 64, 0, 1));
+    }
+
+    std::vector<size_t> level;
+    std::vector<vertex_index_t> parent;
+    ASSERT_TRUE(simple_graph::parallel_bfs(g, 128, &level, &parent));
+    ASSERT_EQ(9 * 64 + 1, level.size());
+    EXPECT_EQ(unreached, level[0]);
+    EXPECT_EQ(0, level[128]);
+    EXPECT_EQ(7, level[9 * 64]);
+    EXPECT_EQ(8 * 64, parent[9 * 64]);
+    EXPECT_EQ(unreached, level[129]);
+}
+
+TEST(ParallelBfsTest, test_invalid_start)
+{
+    auto g = make_random<true>(10, 2, 5);
+    std::vector<size_t> level;
+    std::vector<vertex_index_t> parent;
+    EXPECT_FALSE(simple_graph::parallel_bfs(g, -1, &level, &parent));
+    EXPECT_FALSE(simple_graph::parallel_bfs(g, 10, &level, &parent));
+}
+
+}  // namespace
+
+int main(int argc, char **argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
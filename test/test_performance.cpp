@@ -1,38 +1,207 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <functional>
+#include <iterator>
+#include <memory_resource>
+#include <numeric>
+#include <optional>
 #include <random>
 #include "benchmark/benchmark.h"
 #include "simple_graph/list_graph.hpp"
+#include "simple_graph/csr_graph.hpp"
+#include "simple_graph/instrument.hpp"
+#include "simple_graph/matrix_graph.hpp"
 #include "simple_graph/algorithm/astar.hpp"
+#include "simple_graph/algorithm/batch.hpp"
 #include "simple_graph/algorithm/bellman_ford.hpp"
 #include "simple_graph/algorithm/bfs.hpp"
 #include "simple_graph/algorithm/dfs.hpp"
+#include "simple_graph/algorithm/dijkstra.hpp"
+#include "simple_graph/algorithm/ms_bfs.hpp"
+#include "simple_graph/algorithm/parallel_bfs.hpp"
 
 using simple_graph::vertex_index_t;
 
+SIMPLE_GRAPH_DEFINE_ALLOCATION_HOOKS
+
+/// Memory resource counting bytes currently allocated through it, used to measure memory footprint of graphs.
+class FootprintResource : public std::pmr::memory_resource {
+public:
+    size_t bytes() const { return bytes_; }
+
+private:
+    void *do_allocate(size_t bytes, size_t alignment) override
+    {
+        bytes_ += bytes;
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void *p, size_t bytes, size_t alignment) override
+    {
+        bytes_ -= bytes;
+        std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override
+    {
+        return this == &other;
+    }
+
+    size_t bytes_ = 0;
+};
+
+/// Build 4-connected grid of `size` x `size` vertices with unit weights.
+static void make_grid(simple_graph::ListGraph<false, std::pair<int, int>, int, ssize_t> &g, int size)
+{
+    for (int i = 0; i < size; ++i) {
+        for (int j = 0; j < size; ++j) {
+            g.add_vertex(simple_graph::Vertex<std::pair<int, int>>(i * size + j, {i, j}));
+        }
+    }
+
+    for (int i = 0; i < size; ++i) {
+        for (int j = 0; j < size; ++j) {
+            if (j != size - 1) {
+                g.add_edge(simple_graph::Edge<int, ssize_t>(i * size + j, i * size + j + 1, 0, 1));
+            }
+            if (i != size - 1) {
+                g.add_edge(simple_graph::Edge<int, ssize_t>(i * size + j, (i + 1) * size + j, 0, 1));
+            }
+        }
+    }
+}
+
+/**
+ * Build of random graph and its destruction, graph storage is allocated from the heap or from an arena.
+ */
+template<bool Arena>
 static void bench_creation(benchmark::State &state)
 {
-    simple_graph::ListGraph<false, int, int, int> g;
-    while (state.KeepRunning()) {
-        state.PauseTiming();
-        std::random_device rd;
-        std::mt19937 gen(rd());
-        std::uniform_int_distribution<> dist(0, state.range(0) - 1);
-        std::set<std::pair<size_t, size_t>> data;
-        for (int j = 0; j < state.range(1); ++j) {
-            data.insert(std::make_pair<int, int>(dist(gen), dist(gen)));
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<> dist(0, state.range(0) - 1);
+    std::set<std::pair<size_t, size_t>> data;
+    for (int j = 0; j < state.range(1); ++j) {
+        data.insert(std::make_pair<int, int>(dist(gen), dist(gen)));
+    }
+
+    double teardown = 0;
+    for (auto _ : state) {
+        std::pmr::monotonic_buffer_resource arena;
+        std::optional<simple_graph::ListGraph<false, int, int, int>> g;
+        if (Arena) {
+            g.emplace(&arena);
+        }
+        else {
+            g.emplace();
         }
-        state.ResumeTiming();
 
         for (int i = 0; i < state.range(0); ++i) {
-            g.add_vertex(simple_graph::Vertex<int>(i));
+            g->add_vertex(simple_graph::Vertex<int>(i));
         }
         for (auto &d : data) {
-            g.add_edge(simple_graph::Edge<int, int>(d.first, d.second, 0));
+            g->add_edge(simple_graph::Edge<int, int>(d.first, d.second, 0));
         }
+
+        auto start = std::chrono::steady_clock::now();
+        g.reset();
+        arena.release();
+        teardown += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
     }
 
+    state.counters["teardown_seconds"] = benchmark::Counter(teardown, benchmark::Counter::kAvgIterations);
     state.SetComplexityN(state.range(0));
 }
-BENCHMARK(bench_creation)->RangePair(1<<10, 8<<16, 100, 1<<12)->Complexity();
+BENCHMARK_TEMPLATE(bench_creation, false)->RangePair(1<<10, 8<<16, 100, 1<<12)->Complexity();
+BENCHMARK_TEMPLATE(bench_creation, true)->RangePair(1<<10, 8<<16, 100, 1<<12)->Complexity();
+
+/**
+ * Build of random graph with edges added one by one or in a single batch.
+ */
+template<bool Batch>
+static void bench_bulk_creation(benchmark::State &state)
+{
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<> dist(0, state.range(0) - 1);
+    std::vector<simple_graph::Edge<int, int>> data;
+    for (int j = 0; j < state.range(1); ++j) {
+        data.emplace_back(dist(gen), dist(gen), 0, 1);
+    }
+
+    for (auto _ : state) {
+        simple_graph::ListGraph<true, int, int, int, true> g;
+        for (int i = 0; i < state.range(0); ++i) {
+            g.add_vertex(simple_graph::Vertex<int>(i));
+        }
+
+        if (Batch) {
+            state.PauseTiming();
+            std::vector<simple_graph::Edge<int, int>> edges(data);
+            state.ResumeTiming();
+            g.add_edges(std::move(edges));
+        }
+        else {
+            for (const auto &edge : data) {
+                g.add_edge(edge);
+            }
+        }
+        benchmark::DoNotOptimize(g.edge_num());
+    }
+
+    state.counters["edges_per_second"] = benchmark::Counter(static_cast<double>(state.range(1)),
+            benchmark::Counter::kIsIterationInvariantRate);
+}
+BENCHMARK_TEMPLATE(bench_bulk_creation, false)->Args({1<<16, 1<<20})->Args({1<<20, 1<<23})->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(bench_bulk_creation, true)->Args({1<<16, 1<<20})->Args({1<<20, 1<<23})->Unit(benchmark::kMillisecond);
+
+/**
+ * Removal of random 10% of vertices of a random graph one by one or in a single batch.
+ */
+template<bool Batch>
+static void bench_rm_vertices(benchmark::State &state)
+{
+    int vnum = static_cast<int>(state.range(0));
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<> dist(0, vnum - 1);
+    std::vector<simple_graph::Edge<int, int>> edges;
+    for (int j = 0; j < 4 * vnum; ++j) {
+        edges.emplace_back(dist(gen), dist(gen), 0, 1);
+    }
+    std::vector<vertex_index_t> removed(vnum);
+    std::iota(removed.begin(), removed.end(), 0);
+    std::shuffle(removed.begin(), removed.end(), gen);
+    removed.resize(vnum / 10);
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        simple_graph::ListGraph<true, int, int, int> g;
+        for (int i = 0; i < vnum; ++i) {
+            g.add_vertex(simple_graph::Vertex<int>(i));
+        }
+        g.add_edges(edges);
+        state.ResumeTiming();
+
+        if (Batch) {
+            g.rm_vertices(removed);
+        }
+        else {
+            for (vertex_index_t idx : removed) {
+                g.rm_vertex(idx);
+            }
+        }
+        benchmark::DoNotOptimize(g.edge_num());
+
+        state.PauseTiming();
+        g = simple_graph::ListGraph<true, int, int, int>();
+        state.ResumeTiming();
+    }
+
+    state.counters["vertices_per_second"] = benchmark::Counter(static_cast<double>(removed.size()),
+            benchmark::Counter::kIsIterationInvariantRate);
+}
+BENCHMARK_TEMPLATE(bench_rm_vertices, false)->Arg(1<<14)->Arg(1<<20)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(bench_rm_vertices, true)->Arg(1<<14)->Arg(1<<20)->Unit(benchmark::kMillisecond);
 
 static void bench_traverse(benchmark::State &state)
 {
@@ -68,10 +237,120 @@ static void bench_traverse(benchmark::State &state)
         }
     }
 
+    state.counters["edges_per_second"] = benchmark::Counter(static_cast<double>(g.edge_num()),
+            benchmark::Counter::kIsIterationInvariantRate);
     state.SetComplexityN(state.range(0));
 }
 BENCHMARK(bench_traverse)->Range(1<<2, 1<<10)->Complexity();
 
+static void bench_expand_outbounds(benchmark::State &state)
+{
+    simple_graph::ListGraph<false, std::pair<int, int>, int, ssize_t> g;
+    make_grid(g, state.range(0));
+    g.filter_edge(simple_graph::Edge<int, ssize_t>(0, 1, 0));
+
+    vertex_index_t vnum = g.vertex_num();
+    simple_graph::instrument::AllocationScope scope;
+    for (auto _ : state) {
+        for (vertex_index_t u = 0; u < vnum; ++u) {
+            for (auto v : g.outbounds(u, 0)) {
+                benchmark::DoNotOptimize(v);
+            }
+        }
+    }
+
+    if (simple_graph::instrument::enabled) {
+        state.counters["allocs_per_expansion"] = static_cast<double>(scope.counters().allocations)
+                / (state.iterations() * vnum);
+    }
+    state.SetItemsProcessed(state.iterations() * vnum);
+}
+BENCHMARK(bench_expand_outbounds)->Range(1<<4, 1<<10);
+
+static void bench_expand_neighbours(benchmark::State &state)
+{
+    simple_graph::ListGraph<false, std::pair<int, int>, int, ssize_t> g;
+    make_grid(g, state.range(0));
+    g.filter_edge(simple_graph::Edge<int, ssize_t>(0, 1, 0));
+
+    vertex_index_t vnum = g.vertex_num();
+    simple_graph::instrument::AllocationScope scope;
+    for (auto _ : state) {
+        for (vertex_index_t u = 0; u < vnum; ++u) {
+            for (const auto &n : g.out_neighbours(u, 0)) {
+                benchmark::DoNotOptimize(n);
+            }
+        }
+    }
+
+    if (simple_graph::instrument::enabled) {
+        state.counters["allocs_per_expansion"] = static_cast<double>(scope.counters().allocations)
+                / (state.iterations() * vnum);
+    }
+    state.SetItemsProcessed(state.iterations() * vnum);
+}
+BENCHMARK(bench_expand_neighbours)->Range(1<<4, 1<<10);
+
+/**
+ * Memory footprint and scan throughput of adjacency lists: bytes held by the graph per edge and rate of
+ * visiting neighbours of all vertices.
+ */
+static void bench_adjacency(benchmark::State &state)
+{
+    FootprintResource resource;
+    simple_graph::ListGraph<false, std::pair<int, int>, int, ssize_t> g(&resource);
+    make_grid(g, state.range(0));
+    size_t bytes = resource.bytes();
+
+    vertex_index_t vnum = g.vertex_num();
+    size_t degrees = 0;
+    for (vertex_index_t u = 0; u < vnum; ++u) {
+        auto neighbours = g.out_neighbours(u, 0);
+        degrees += std::distance(neighbours.begin(), neighbours.end());
+    }
+
+    for (auto _ : state) {
+        for (vertex_index_t u = 0; u < vnum; ++u) {
+            for (const auto &n : g.out_neighbours(u, 0)) {
+                benchmark::DoNotOptimize(n);
+            }
+        }
+    }
+
+    state.counters["bytes_per_edge"] = static_cast<double>(bytes) / g.edge_num();
+    state.counters["neighbours_per_second"] = benchmark::Counter(static_cast<double>(degrees),
+            benchmark::Counter::kIsIterationInvariantRate);
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK(bench_adjacency)->Range(1<<4, 1<<10)->Complexity();
+
+/**
+ * Lookup of edges by endpoints, half of the looked up edges are absent.
+ */
+static void bench_edge_lookup(benchmark::State &state)
+{
+    simple_graph::ListGraph<false, std::pair<int, int>, int, ssize_t> g;
+    make_grid(g, state.range(0));
+
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<vertex_index_t> dist(0, g.vertex_num() - 1);
+    std::vector<std::pair<vertex_index_t, vertex_index_t>> queries;
+    for (size_t i = 0; i < 1024; ++i) {
+        vertex_index_t u = dist(gen);
+        vertex_index_t v = (i % 2 == 0) ? dist(gen) : (u + 1) % g.vertex_num();
+        queries.emplace_back(u, v);
+    }
+
+    for (auto _ : state) {
+        for (const auto &q : queries) {
+            benchmark::DoNotOptimize(g.edge_exists(simple_graph::Edge<int, ssize_t>(q.first, q.second, 0)));
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * queries.size());
+}
+BENCHMARK(bench_edge_lookup)->Range(1<<4, 1<<10);
+
 static void bench_bfs_path_length(benchmark::State &state)
 {
     simple_graph::ListGraph<false, int, int,  ssize_t> g;
@@ -137,6 +416,27 @@ static void bench_astar_path_length(benchmark::State &state)
 }
 BENCHMARK(bench_astar_path_length)->Range(1<<10, 1<<20)->Complexity();
 
+static void bench_dijkstra_path_length(benchmark::State &state)
+{
+    simple_graph::ListGraph<false, int, int, ssize_t> g;
+    for (int i = 0; i < state.range(0); ++i) {
+        g.add_vertex(simple_graph::Vertex<int>(i, i));
+    }
+    for (int i = 0; i < state.range(0) - 1; ++i) {
+        g.add_edge(simple_graph::Edge<int, ssize_t>(i, i + 1, 0, 1));
+    }
+
+    std::function<bool(int)> f = [&](int c) { return c == state.range(0) - 1; };
+
+    for (auto _ : state) {
+        std::vector<vertex_index_t> path;
+        benchmark::DoNotOptimize(simple_graph::dijkstra(g, 0, f, &path));
+    }
+
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK(bench_dijkstra_path_length)->Range(1<<10, 1<<20)->Complexity();
+
 static void bench_astar(benchmark::State &state)
 {
     simple_graph::ListGraph<false, std::pair<int, int>, int, ssize_t> g;
@@ -182,7 +482,59 @@ static void bench_astar(benchmark::State &state)
 
     state.SetComplexityN(state.range(0));
 }
-BENCHMARK(bench_astar)->Range(1<<2, 1<<8)->Complexity();
+BENCHMARK(bench_astar)->Range(1<<2, 1<<10)->Complexity();
+
+template<size_t Arity>
+static void bench_astar_heap(benchmark::State &state)
+{
+    simple_graph::ListGraph<false, std::pair<int, int>, int, ssize_t> g;
+    make_grid(g, state.range(0));
+
+    auto heuristic = [&state](vertex_index_t c, vertex_index_t r) {
+        int ci = c / state.range(0);
+        int cj = c % state.range(0);
+
+        int ri = r / state.range(0);
+        int rj = r % state.range(0);
+
+        return std::sqrt(std::pow(ci - ri, 2) + std::pow(cj - rj, 2));
+    };
+
+    for (auto _ : state) {
+        std::vector<vertex_index_t> path;
+        benchmark::DoNotOptimize(simple_graph::astar<Arity>(g, 0, state.range(0) * state.range(0) - 1,
+                heuristic, &path));
+    }
+
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK_TEMPLATE(bench_astar_heap, 2)->Range(1<<2, 1<<10)->Complexity();
+BENCHMARK_TEMPLATE(bench_astar_heap, 4)->Range(1<<2, 1<<10)->Complexity();
+
+static void bench_astar_frozen(benchmark::State &state)
+{
+    simple_graph::ListGraph<false, std::pair<int, int>, int, ssize_t> lg;
+    make_grid(lg, state.range(0));
+    auto g = simple_graph::freeze(lg);
+
+    auto heuristic = [&state](vertex_index_t c, vertex_index_t r) {
+        int ci = c / state.range(0);
+        int cj = c % state.range(0);
+
+        int ri = r / state.range(0);
+        int rj = r % state.range(0);
+
+        return std::sqrt(std::pow(ci - ri, 2) + std::pow(cj - rj, 2));
+    };
+
+    for (auto _ : state) {
+        std::vector<vertex_index_t> path;
+        benchmark::DoNotOptimize(simple_graph::astar(g, 0, state.range(0) * state.range(0) - 1, heuristic, &path));
+    }
+
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK(bench_astar_frozen)->Range(1<<2, 1<<8)->Complexity();
 
 static void bench_bellman_ford(benchmark::State &state)
 {
@@ -221,4 +573,335 @@ static void bench_bellman_ford(benchmark::State &state)
 }
 BENCHMARK(bench_bellman_ford)->Range(1<<2, 1<<8)->Complexity();
 
+static void bench_dijkstra(benchmark::State &state)
+{
+    simple_graph::ListGraph<false, std::pair<int, int>, int, ssize_t> g;
+    make_grid(g, state.range(0));
+
+    std::function<bool(std::pair<int, int>)> f = [&](std::pair<int, int> c) {
+        return (c.first == state.range(0) - 1) && (c.second == state.range(0) - 1);
+    };
+
+    for (auto _ : state) {
+        std::vector<vertex_index_t> path;
+        benchmark::DoNotOptimize(simple_graph::dijkstra(g, 0, f, &path));
+    }
+
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK(bench_dijkstra)->Range(1<<2, 1<<8)->Complexity();
+
+/**
+ * Short queries on a large graph, cost of per-query state initialization dominates the search itself.
+ */
+template<bool Reuse>
+static void bench_dijkstra_short_queries(benchmark::State &state)
+{
+    simple_graph::ListGraph<false, std::pair<int, int>, int, ssize_t> g;
+    make_grid(g, state.range(0));
+
+    /// Target is a direct neighbour of the start vertex.
+    std::function<bool(std::pair<int, int>)> f = [](std::pair<int, int> c) {
+        return (c.first == 1) && (c.second == 0);
+    };
+
+    simple_graph::DijkstraContext<ssize_t> context;
+    for (auto _ : state) {
+        std::vector<vertex_index_t> path;
+        if (Reuse) {
+            benchmark::DoNotOptimize(simple_graph::dijkstra(g, 0, f, &path, &context));
+        }
+        else {
+            benchmark::DoNotOptimize(simple_graph::dijkstra(g, 0, f, &path));
+        }
+    }
+
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK_TEMPLATE(bench_dijkstra_short_queries, false)->Range(1<<4, 1<<10)->Complexity();
+BENCHMARK_TEMPLATE(bench_dijkstra_short_queries, true)->Range(1<<4, 1<<10)->Complexity();
+
+/**
+ * Full BFS over a frozen grid, predicate is called for every vertex and never matches.
+ *
+ * @tparam Kind 0 for std::function taking vertex data, 1 for lambda taking vertex data, 2 for lambda taking
+ *         vertex index.
+ */
+template<int Kind>
+static void bench_bfs_predicate(benchmark::State &state)
+{
+    simple_graph::ListGraph<false, std::pair<int, int>, int, ssize_t> lg;
+    make_grid(lg, state.range(0));
+    auto g = simple_graph::freeze(lg);
+
+    auto data_pred = [](const std::pair<int, int> &c) { return c.first < 0; };
+    std::function<bool(std::pair<int, int>)> function_pred = data_pred;
+    auto index_pred = simple_graph::by_index([](vertex_index_t idx) { return idx < 0; });
+
+    simple_graph::TraversalContext context;
+    for (auto _ : state) {
+        std::vector<vertex_index_t> path;
+        if (Kind == 0) {
+            benchmark::DoNotOptimize(simple_graph::bfs(g, 0, function_pred, &path, &context));
+        }
+        else if (Kind == 1) {
+            benchmark::DoNotOptimize(simple_graph::bfs(g, 0, data_pred, &path, &context));
+        }
+        else {
+            benchmark::DoNotOptimize(simple_graph::bfs(g, 0, index_pred, &path, &context));
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0) * state.range(0));
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK_TEMPLATE(bench_bfs_predicate, 0)->Range(1<<4, 1<<9)->Complexity();
+BENCHMARK_TEMPLATE(bench_bfs_predicate, 1)->Range(1<<4, 1<<9)->Complexity();
+BENCHMARK_TEMPLATE(bench_bfs_predicate, 2)->Range(1<<4, 1<<9)->Complexity();
+
+/**
+ * A* over a frozen grid with heuristic passed as std::function or as lambda.
+ */
+template<bool Lambda>
+static void bench_astar_heuristic(benchmark::State &state)
+{
+    simple_graph::ListGraph<false, std::pair<int, int>, int, ssize_t> lg;
+    make_grid(lg, state.range(0));
+    auto g = simple_graph::freeze(lg);
+
+    int size = state.range(0);
+    auto heuristic = [size](vertex_index_t c, vertex_index_t r) {
+        return static_cast<float>(std::abs(c / size - r / size) + std::abs(c % size - r % size));
+    };
+    std::function<float(vertex_index_t, vertex_index_t)> function_heuristic = heuristic;
+
+    simple_graph::AstarContext<> context;
+    for (auto _ : state) {
+        std::vector<vertex_index_t> path;
+        if (Lambda) {
+            benchmark::DoNotOptimize(simple_graph::astar(g, 0, size * size - 1, heuristic, &path, &context));
+        }
+        else {
+            benchmark::DoNotOptimize(simple_graph::astar(g, 0, size * size - 1, function_heuristic, &path,
+                    &context));
+        }
+    }
+
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK_TEMPLATE(bench_astar_heuristic, false)->Range(1<<4, 1<<9)->Complexity();
+BENCHMARK_TEMPLATE(bench_astar_heuristic, true)->Range(1<<4, 1<<9)->Complexity();
+
+/**
+ * Dijkstra over a frozen grid instantiated against the concrete graph type or against the Graph interface.
+ */
+template<bool Erased>
+static void bench_dijkstra_dispatch(benchmark::State &state)
+{
+    simple_graph::ListGraph<false, std::pair<int, int>, int, ssize_t> lg;
+    make_grid(lg, state.range(0));
+    auto cg = simple_graph::freeze(lg);
+    const simple_graph::Graph<false, std::pair<int, int>, int, ssize_t> &eg = cg;
+
+    simple_graph::DijkstraContext<ssize_t> context;
+    for (auto _ : state) {
+        if (Erased) {
+            benchmark::DoNotOptimize(simple_graph::dijkstra(eg, 0, &context));
+        }
+        else {
+            benchmark::DoNotOptimize(simple_graph::dijkstra(cg, 0, &context));
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0) * state.range(0));
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK_TEMPLATE(bench_dijkstra_dispatch, true)->Range(1<<4, 1<<9)->Complexity();
+BENCHMARK_TEMPLATE(bench_dijkstra_dispatch, false)->Range(1<<4, 1<<9)->Complexity();
+
+/**
+ * Full breadth-first traversal of dense random graph with 15% of possible edges, adjacency lists versus
+ * bit rows of adjacency matrix.
+ */
+template<typename G, typename Context>
+static void bench_bfs_dense(benchmark::State &state)
+{
+    G g;
+    vertex_index_t vnum = state.range(0);
+    for (vertex_index_t i = 0; i < vnum; ++i) {
+        g.add_vertex(simple_graph::Vertex<int>(i, 0));
+    }
+
+    std::mt19937 gen(42);
+    std::bernoulli_distribution dist(0.15);
+    for (vertex_index_t i = 0; i < vnum; ++i) {
+        for (vertex_index_t j = 0; j < vnum; ++j) {
+            if ((i != j) && dist(gen)) {
+                g.add_edge(simple_graph::Edge<int, int>(i, j, 0));
+            }
+        }
+    }
+
+    Context context;
+    std::vector<vertex_index_t> path;
+    for (auto _ : state) {
+        path.clear();
+        benchmark::DoNotOptimize(simple_graph::bfs(g, 0, [](int data) { return data != 0; }, &path, &context));
+    }
+
+    state.counters["edges_per_second"] = benchmark::Counter(static_cast<double>(g.edge_num()),
+            benchmark::Counter::kIsIterationInvariantRate);
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK_TEMPLATE(bench_bfs_dense, simple_graph::ListGraph<true, int, int, int>,
+        simple_graph::TraversalContext)->Range(1<<8, 1<<12);
+BENCHMARK_TEMPLATE(bench_bfs_dense, simple_graph::MatrixGraph<true, int, int, int>,
+        simple_graph::BitTraversalContext)->Range(1<<8, 1<<12);
+
+/**
+ * Throughput of independent A* queries between random vertices of a grid versus number of worker threads.
+ */
+static void bench_batch_queries(benchmark::State &state)
+{
+    static simple_graph::ListGraph<false, std::pair<int, int>, int, ssize_t> g;
+    const int size = 256;
+    if (g.vertex_num() == 0) {
+        make_grid(g, size);
+    }
+
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<vertex_index_t> dist(0, size * size - 1);
+    std::vector<std::pair<vertex_index_t, vertex_index_t>> queries(1024);
+    for (auto &q : queries) {
+        q = {dist(gen), dist(gen)};
+    }
+
+    auto heuristic = [](vertex_index_t c, vertex_index_t r) {
+        return static_cast<float>(std::abs(c / size - r / size) + std::abs(c % size - r % size));
+    };
+
+    simple_graph::ThreadPool pool(state.range(0));
+    simple_graph::BatchSearch<decltype(g)> batch(g, &pool);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(batch.astar(queries, heuristic));
+    }
+
+    state.SetItemsProcessed(state.iterations() * queries.size());
+    state.counters["threads"] = static_cast<double>(batch.threads());
+}
+BENCHMARK(bench_batch_queries)->Arg(1)->Arg(2)->Arg(4)->Arg(8)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+/**
+ * Undirected power-law graph of 2^scale vertices and edge_factor * 2^scale edge samples made by R-MAT generator
+ * with Graph500 parameters, duplicates and self-loops are dropped.
+ */
+static const simple_graph::ListGraph<false, int, int, int> &rmat_graph(int scale, int edge_factor)
+{
+    static simple_graph::ListGraph<false, int, int, int> g;
+    if (g.vertex_num() != 0) {
+        return g;
+    }
+
+    vertex_index_t vnum = vertex_index_t(1) << scale;
+    for (vertex_index_t i = 0; i < vnum; ++i) {
+        g.add_vertex(simple_graph::Vertex<int>(i, 0));
+    }
+
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<double> dist(0.0, 1.0);
+    std::vector<simple_graph::Edge<int, int>> edges;
+    for (vertex_index_t k = 0; k < vnum * edge_factor; ++k) {
+        vertex_index_t i = 0;
+        vertex_index_t j = 0;
+        for (int bit = 0; bit < scale; ++bit) {
+            double r = dist(gen);
+            /// Quadrant probabilities a = 0.57, b = 0.19, c = 0.19, d = 0.05.
+            i = (i << 1) | (r >= 0.76 ? 1 : 0);
+            j = (j << 1) | (((r >= 0.57) && (r < 0.76)) || (r >= 0.95) ? 1 : 0);
+        }
+        if (i != j) {
+            edges.emplace_back(i, j, 0);
+        }
+    }
+    g.add_edges(std::move(edges));
+    return g;
+}
+
+/**
+ * Full breadth-first traversal of power-law graph from its hub vertex by sequential BFS.
+ */
+static void bench_bfs_power_law(benchmark::State &state)
+{
+    const auto &g = rmat_graph(16, 16);
+
+    simple_graph::TraversalContext context;
+    std::vector<vertex_index_t> path;
+    for (auto _ : state) {
+        path.clear();
+        benchmark::DoNotOptimize(simple_graph::bfs(g, 0, [](int data) { return data != 0; }, &path, &context));
+    }
+
+    state.counters["edges_per_second"] = benchmark::Counter(static_cast<double>(g.edge_num()),
+            benchmark::Counter::kIsIterationInvariantRate);
+}
+BENCHMARK(bench_bfs_power_law)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+/**
+ * Direction-optimizing parallel BFS over the same power-law graph versus number of worker threads.
+ */
+static void bench_parallel_bfs(benchmark::State &state)
+{
+    const auto &g = rmat_graph(16, 16);
+
+    simple_graph::ThreadPool pool(state.range(0));
+    std::vector<size_t> level;
+    std::vector<vertex_index_t> parent;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(simple_graph::parallel_bfs(g, 0, &level, &parent, &pool));
+    }
+
+    state.counters["edges_per_second"] = benchmark::Counter(static_cast<double>(g.edge_num()),
+            benchmark::Counter::kIsIterationInvariantRate);
+    state.counters["threads"] = static_cast<double>(pool.size());
+}
+BENCHMARK(bench_parallel_bfs)->Arg(1)->Arg(2)->Arg(4)->Arg(8)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+/**
+ * Hop distances from 256 random sources of power-law graph: sequential BFS per source versus multi-source BFS
+ * with 64 and 256 sources per batch.
+ */
+template<size_t Words>
+static void bench_ms_bfs(benchmark::State &state)
+{
+    const auto &g = rmat_graph(16, 16);
+
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<vertex_index_t> dist(0, g.vertex_num() - 1);
+    std::vector<vertex_index_t> sources(256);
+    for (auto &s : sources) {
+        s = dist(gen);
+    }
+
+    std::vector<std::vector<size_t>> level;
+    simple_graph::TraversalContext context;
+    std::vector<vertex_index_t> path;
+    for (auto _ : state) {
+        if constexpr (Words == 0) {
+            for (vertex_index_t s : sources) {
+                path.clear();
+                benchmark::DoNotOptimize(simple_graph::bfs(g, s, [](int data) { return data != 0; }, &path,
+                        &context));
+            }
+        }
+        else {
+            benchmark::DoNotOptimize(simple_graph::ms_bfs_levels<Words>(g, sources, &level));
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * sources.size());
+}
+BENCHMARK_TEMPLATE(bench_ms_bfs, 0)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(bench_ms_bfs, 1)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(bench_ms_bfs, 4)->Unit(benchmark::kMillisecond);
+
 BENCHMARK_MAIN();
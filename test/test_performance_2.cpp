@@ -1,6 +1,8 @@
 #include <iostream>
+#include <string>
 #include <vector>
 #include "simple_graph/list_graph.hpp"
+#include "simple_graph/algorithm/bfs.hpp"
 
 class EdgeProperties {
 public:
@@ -14,10 +16,9 @@ public:
         ++creations;
     }
 
-    EdgeProperties(EdgeProperties &&ep) noexcept(true)
+    EdgeProperties(EdgeProperties &&ep) noexcept(true) : data_(ep.data_)
     {
         ++moves;
-        std::swap(data_, ep.data_);
     }
 
     EdgeProperties(const EdgeProperties &ep) : data_(ep.data_)
@@ -38,10 +39,7 @@ public:
     EdgeProperties &operator=(EdgeProperties &&ep) noexcept(true)
     {
         ++assign_moves;
-        if (this != &ep) {
-            std::swap(data_, ep.data_);
-        }
-
+        data_ = ep.data_;
         return *this;
     }
 
@@ -73,6 +71,13 @@ int EdgeProperties::moves = 0;
 int EdgeProperties::assigns = 0;
 int EdgeProperties::assign_moves = 0;
 
+static void print_counters(const char *name, const simple_graph::ObjectCounters &c)
+{
+    std::cout << name << " stat: creations: " << c.default_creations << " + " << c.creations
+            << "; copies: " << c.copies
+            << "; moves: " << c.moves
+            << "; assigns: " << c.assigns << std::endl;
+}
 
 int main()
 {
@@ -87,17 +92,41 @@ int main()
         data.push_back(std::make_pair<int, int>(j + 1, j + 1000));
     }
 
+    using Payload = std::vector<int>;
     for (int k = 0; k < K; ++k) {
-        simple_graph::ListGraph<false, int, EdgeProperties, int> g;
+        simple_graph::ListGraph<false, Payload, EdgeProperties, int> g;
         for (int i = 0; i < X; ++i) {
-            g.add_vertex(simple_graph::Vertex<int>(i));
+            if (i % 2) {
+                g.add_vertex(simple_graph::Vertex<Payload>(i, Payload(4, i)));
+            }
+            else {
+                g.emplace_vertex(i, 4, i);
+            }
         }
-        for (auto &d : data) {
-            g.add_edge(simple_graph::Edge<EdgeProperties, int>(d.first, d.second, 8));
+        for (size_t i = 0; i < data.size(); ++i) {
+            if (i % 2) {
+                g.add_edge(simple_graph::Edge<EdgeProperties, int>(data[i].first, data[i].second, 8));
+            }
+            else {
+                g.emplace_edge(data[i].first, data[i].second, 1, 8);
+            }
         }
+
+        /// Hot path of a query: predicate gets vertex data of every discovered vertex.
+        std::vector<simple_graph::vertex_index_t> path;
+        simple_graph::bfs(g, 1, [](const Payload &p) { return p[0] < 0; }, &path);
     }
 
-    std::cout << "vertex stat: " << simple_graph::Vertex<int>::stat() << std::endl;
-    std::cout << "edge stat: " << simple_graph::Edge<EdgeProperties, int>::stat() << std::endl;
+    simple_graph::ObjectCounters vc = simple_graph::Vertex<Payload>::counters();
+    simple_graph::ObjectCounters ec = simple_graph::Edge<EdgeProperties, int>::counters();
+    print_counters("vertex", vc);
+    print_counters("edge", ec);
     std::cout << "edge properties: " << EdgeProperties::stat() << std::endl;
+
+    /// Graph building and traversal must not copy payloads.
+    if (vc.copies || vc.assigns || ec.copies || ec.assigns || EdgeProperties::copies || EdgeProperties::assigns) {
+        std::cout << "unexpected copies" << std::endl;
+        return 1;
+    }
+    return 0;
 }
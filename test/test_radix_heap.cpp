@@ -0,0 +1,72 @@
+#include <algorithm>
+#include <random>
+#include <gtest/gtest.h>
+#include "simple_graph/radix_heap.hpp"
+
+namespace {
+
+using simple_graph::vertex_index_t;
+
+TEST(RadixHeapTest, test_push_pop)
+{
+    simple_graph::RadixHeap<int> heap;
+    EXPECT_TRUE(heap.empty());
+
+    heap.push(3, 30);
+    heap.push(1, 10);
+    heap.push(2, 20);
+    heap.push(0, 0);
+    ASSERT_EQ(4, heap.size());
+
+    EXPECT_EQ(0, heap.pop());
+    EXPECT_EQ(0, heap.last());
+    EXPECT_EQ(1, heap.pop());
+    EXPECT_EQ(10, heap.last());
+
+    /// Keys not less than the last popped one are allowed.
+    heap.push(4, 10);
+    heap.update(3, 15);
+    EXPECT_EQ(4, heap.pop());
+    EXPECT_EQ(3, heap.pop());
+    EXPECT_EQ(15, heap.last());
+    EXPECT_EQ(2, heap.pop());
+    EXPECT_EQ(3, heap.pop());
+    EXPECT_EQ(30, heap.last());
+    EXPECT_TRUE(heap.empty());
+}
+
+TEST(RadixHeapTest, test_monotone_random)
+{
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<int64_t> dist(0, 1000000);
+
+    simple_graph::RadixHeap<int64_t> heap;
+    std::vector<int64_t> keys;
+    for (vertex_index_t i = 0; i < 1000; ++i) {
+        keys.push_back(dist(gen));
+        heap.push(i, keys.back());
+    }
+
+    int64_t last = 0;
+    while (!heap.empty()) {
+        vertex_index_t idx = heap.pop();
+        EXPECT_LE(last, keys[idx]);
+        EXPECT_EQ(keys[idx], heap.last());
+        last = keys[idx];
+
+        /// Push some keys greater than the last popped one like Dijkstra algorithm does.
+        if (keys.size() < 2000) {
+            keys.push_back(last + dist(gen) % 100);
+            heap.push(keys.size() - 1, keys.back());
+        }
+    }
+    EXPECT_EQ(2000, keys.size());
+}
+
+}  // namespace
+
+int main(int argc, char **argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,148 @@
+#include <functional>
+#include <limits>
+#include <random>
+#include <gtest/gtest.h>
+#include "simple_graph/list_graph.hpp"
+#include "simple_graph/search_context.hpp"
+#include "simple_graph/algorithm/astar.hpp"
+#include "simple_graph/algorithm/bfs.hpp"
+#include "simple_graph/algorithm/dfs.hpp"
+#include "simple_graph/algorithm/dijkstra.hpp"
+
+namespace {
+
+using simple_graph::vertex_index_t;
+
+TEST(SearchContextTest, test_reset)
+{
+    simple_graph::TraversalContext context;
+    context.reset(4);
+    EXPECT_FALSE(context.visited(0));
+    EXPECT_EQ(std::numeric_limits<size_t>::max(), context.distance(0));
+    EXPECT_EQ(-1, context.predecessor(0));
+
+    context.visit(0);
+    context.set_distance(1, 5);
+    context.set_predecessor(1, 0);
+    context.queue().push_back(1);
+    EXPECT_TRUE(context.visited(0));
+    EXPECT_FALSE(context.visited(1));
+    EXPECT_EQ(5, context.distance(1));
+    EXPECT_EQ(0, context.predecessor(1));
+
+    /// Everything written by the previous query is forgotten.
+    context.reset(8);
+    EXPECT_FALSE(context.visited(0));
+    EXPECT_EQ(std::numeric_limits<size_t>::max(), context.distance(1));
+    EXPECT_EQ(-1, context.predecessor(1));
+    EXPECT_TRUE(context.queue().empty());
+
+    context.visit(7);
+    EXPECT_TRUE(context.visited(7));
+}
+
+class SearchContextGraphTest : public ::testing::Test {
+protected:
+    virtual void SetUp() {
+        std::mt19937 gen(11);
+        std::uniform_int_distribution<int> vertex_dist(0, size - 1);
+        std::uniform_int_distribution<int> weight_dist(1, 100);
+
+        for (int i = 0; i < size; ++i) {
+            g.add_vertex(simple_graph::Vertex<int>(i, i));
+        }
+        for (int i = 0; i < size * 3; ++i) {
+            int idx1 = vertex_dist(gen);
+            int idx2 = vertex_dist(gen);
+            if ((idx1 != idx2) && !g.edge_exists(simple_graph::Edge<int, int>(idx1, idx2, 0))) {
+                g.add_edge(simple_graph::Edge<int, int>(idx1, idx2, 0, weight_dist(gen)));
+            }
+        }
+    }
+
+    static constexpr int size = 100;
+    simple_graph::ListGraph<true, int, int, int> g;
+};
+
+TEST_F(SearchContextGraphTest, test_bfs_dfs_reuse)
+{
+    simple_graph::TraversalContext context;
+    for (int start = 0; start < size; start += 7) {
+        for (int goal = 0; goal < size; goal += 13) {
+            std::function<bool(int)> pred = [goal](int v) { return v == goal; };
+
+            std::vector<vertex_index_t> expected;
+            std::vector<vertex_index_t> actual;
+            EXPECT_EQ(simple_graph::bfs(g, start, pred, &expected),
+                    simple_graph::bfs(g, start, pred, &actual, &context));
+            EXPECT_EQ(expected, actual);
+
+            expected.clear();
+            actual.clear();
+            EXPECT_EQ(simple_graph::dfs(g, start, pred, &expected),
+                    simple_graph::dfs(g, start, pred, &actual, &context));
+            EXPECT_EQ(expected, actual);
+        }
+    }
+}
+
+TEST_F(SearchContextGraphTest, test_dijkstra_reuse)
+{
+    simple_graph::DijkstraContext<int> context;
+    for (int start = 0; start < size; start += 7) {
+        std::vector<int> distance;
+        std::vector<vertex_index_t> predecessor;
+        ASSERT_TRUE(simple_graph::dijkstra(g, start, &distance, &predecessor));
+
+        ASSERT_TRUE(simple_graph::dijkstra(g, start, &context));
+        for (int i = 0; i < size; ++i) {
+            EXPECT_EQ(distance[i], context.distance(i));
+        }
+    }
+}
+
+TEST_F(SearchContextGraphTest, test_astar_reuse)
+{
+    /// Context may be used with graphs of different size.
+    simple_graph::ListGraph<false, int, int, int> small;
+    for (int i = 0; i < 3; ++i) {
+        small.add_vertex(simple_graph::Vertex<int>(i, i));
+    }
+    small.add_edge(simple_graph::Edge<int, int>(0, 1, 0, 1));
+    small.add_edge(simple_graph::Edge<int, int>(1, 2, 0, 1));
+
+    auto heuristic = [](vertex_index_t, vertex_index_t) { return 0.0f; };
+    simple_graph::AstarContext<> context;
+    for (int goal = 0; goal < size; goal += 3) {
+        std::vector<vertex_index_t> expected;
+        std::vector<vertex_index_t> actual;
+        bool found = simple_graph::astar(g, 0, goal, heuristic, &expected);
+        EXPECT_EQ(found, simple_graph::astar(g, 0, goal, heuristic, &actual, &context));
+        if (found) {
+            std::function<bool(int)> pred = [goal](int v) { return v == goal; };
+            std::vector<vertex_index_t> shortest;
+            ASSERT_TRUE(simple_graph::dijkstra(g, 0, pred, &shortest));
+            auto cost = [this](const std::vector<vertex_index_t> &path) {
+                int res = 0;
+                for (size_t i = 1; i < path.size(); ++i) {
+                    res += g.edge(path[i - 1], path[i]).weight();
+                }
+                return res;
+            };
+            EXPECT_EQ(goal, actual.back());
+            EXPECT_EQ(cost(shortest), cost(actual));
+        }
+
+        actual.clear();
+        ASSERT_TRUE(simple_graph::astar(small, 2, 0, heuristic, &actual, &context));
+        EXPECT_EQ(std::vector<vertex_index_t>({2, 1, 0}), actual);
+    }
+}
+
+}  // namespace
+
+int main(int argc, char **argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
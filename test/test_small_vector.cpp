@@ -0,0 +1,114 @@
+#include <memory_resource>
+#include <utility>
+#include <vector>
+#include <gtest/gtest.h>
+#include "simple_graph/small_vector.hpp"
+
+namespace {
+
+TEST(SmallVectorTest, test_inline)
+{
+    simple_graph::SmallVector<int, 4> v;
+    EXPECT_TRUE(v.empty());
+    EXPECT_TRUE(v.is_inline());
+
+    v.push_back(1);
+    v.push_back(3);
+    v.insert(v.begin() + 1, 2);
+    v.insert(v.begin(), 0);
+    EXPECT_TRUE(v.is_inline());
+    EXPECT_EQ(std::vector<int>({0, 1, 2, 3}), std::vector<int>(v.begin(), v.end()));
+
+    v.erase(v.begin() + 2);
+    EXPECT_EQ(std::vector<int>({0, 1, 3}), std::vector<int>(v.begin(), v.end()));
+}
+
+TEST(SmallVectorTest, test_spill)
+{
+    simple_graph::SmallVector<int, 2> v;
+    for (int i = 0; i < 100; ++i) {
+        v.insert(v.begin(), i);
+    }
+    EXPECT_FALSE(v.is_inline());
+    EXPECT_EQ(100, v.size());
+    EXPECT_EQ(99, v[0]);
+    EXPECT_EQ(0, v[99]);
+
+    /// Heap block is freed as soon as elements fit inline storage.
+    while (v.size() > 2) {
+        v.erase(v.begin());
+    }
+    v.shrink_to_fit();
+    EXPECT_TRUE(v.is_inline());
+    EXPECT_EQ(1, v[0]);
+    EXPECT_EQ(0, v[1]);
+}
+
+TEST(SmallVectorTest, test_resize)
+{
+    simple_graph::SmallVector<int, 2> v;
+    v.push_back(7);
+    v.resize(5);
+    EXPECT_FALSE(v.is_inline());
+    EXPECT_EQ(std::vector<int>({7, 0, 0, 0, 0}), std::vector<int>(v.begin(), v.end()));
+
+    v.resize(1);
+    EXPECT_EQ(std::vector<int>({7}), std::vector<int>(v.begin(), v.end()));
+}
+
+TEST(SmallVectorTest, test_copy_move)
+{
+    simple_graph::SmallVector<int, 2> small;
+    small.push_back(1);
+    simple_graph::SmallVector<int, 2> large;
+    for (int i = 0; i < 10; ++i) {
+        large.push_back(i);
+    }
+
+    auto copy = large;
+    EXPECT_EQ(std::vector<int>(large.begin(), large.end()), std::vector<int>(copy.begin(), copy.end()));
+    copy = small;
+    EXPECT_EQ(1, copy.size());
+    EXPECT_EQ(1, copy[0]);
+
+    auto moved = std::move(large);
+    EXPECT_TRUE(large.empty());
+    EXPECT_TRUE(large.is_inline());
+    EXPECT_EQ(10, moved.size());
+    EXPECT_EQ(9, moved[9]);
+
+    moved = std::move(small);
+    EXPECT_EQ(1, moved.size());
+    EXPECT_TRUE(moved.is_inline());
+}
+
+TEST(SmallVectorTest, test_allocator)
+{
+    using Vector = simple_graph::SmallVector<int, 2, std::pmr::polymorphic_allocator<int>>;
+    std::pmr::monotonic_buffer_resource arena;
+
+    Vector v(&arena);
+    for (int i = 0; i < 10; ++i) {
+        v.push_back(i);
+    }
+    EXPECT_EQ(&arena, v.get_allocator().resource());
+
+    /// Allocator stays with the array, elements are copied between different resources.
+    Vector other;
+    other = std::move(v);
+    EXPECT_EQ(std::pmr::get_default_resource(), other.get_allocator().resource());
+    EXPECT_EQ(10, other.size());
+    EXPECT_EQ(9, other[9]);
+
+    Vector moved(std::move(other), &arena);
+    EXPECT_EQ(&arena, moved.get_allocator().resource());
+    EXPECT_EQ(10, moved.size());
+}
+
+}  // namespace
+
+int main(int argc, char **argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,81 @@
+#include <algorithm>
+#include <functional>
+#include <random>
+#include <utility>
+#include <vector>
+#include <gtest/gtest.h>
+#include "simple_graph/sort.hpp"
+
+namespace {
+
+std::vector<int> random_values(size_t size, int bound)
+{
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<> dist(0, bound);
+    std::vector<int> values(size);
+    for (auto &v : values) {
+        v = dist(gen);
+    }
+    return values;
+}
+
+TEST(ParallelSortTest, test_small)
+{
+    std::vector<int> values({5, 3, 9, 1, 3});
+    simple_graph::detail::parallel_sort(values.begin(), values.end(), std::less<int>(), 4);
+    EXPECT_EQ(std::vector<int>({1, 3, 3, 5, 9}), values);
+
+    std::vector<int> empty;
+    simple_graph::detail::parallel_sort(empty.begin(), empty.end(), std::less<int>(), 4);
+    EXPECT_TRUE(empty.empty());
+}
+
+TEST(ParallelSortTest, test_threads)
+{
+    std::vector<int> expected = random_values(100000, 1000);
+    std::vector<int> values = expected;
+    std::sort(expected.begin(), expected.end());
+
+    /// Odd numbers of chunks leave a chunk unmerged for a round.
+    for (size_t threads : {1, 2, 3, 5, 6, 64}) {
+        std::vector<int> sorted = values;
+        simple_graph::detail::parallel_sort(sorted.begin(), sorted.end(), std::less<int>(), threads);
+        EXPECT_EQ(expected, sorted) << threads << " threads";
+    }
+}
+
+TEST(ParallelSortTest, test_comparator)
+{
+    std::vector<int> keys = random_values(50000, 100);
+    std::vector<std::pair<int, size_t>> values;
+    for (size_t i = 0; i < keys.size(); ++i) {
+        values.emplace_back(keys[i], i);
+    }
+    auto greater = [](const std::pair<int, size_t> &a, const std::pair<int, size_t> &b) { return a > b; };
+    simple_graph::detail::parallel_sort(values.begin(), values.end(), greater, 3);
+    EXPECT_TRUE(std::is_sorted(values.begin(), values.end(), greater));
+}
+
+TEST(CountingSortTest, test_stable)
+{
+    std::vector<std::pair<int, size_t>> values;
+    std::vector<int> keys = random_values(10000, 99);
+    for (size_t i = 0; i < keys.size(); ++i) {
+        values.emplace_back(keys[i], i);
+    }
+
+    std::vector<std::pair<int, size_t>> sorted;
+    simple_graph::detail::counting_sort(values, &sorted, 100, [](const std::pair<int, size_t> &v) { return v.first; });
+
+    /// Pairs are unique, so stable sort by the first element gives the same order as sort of pairs.
+    std::sort(values.begin(), values.end());
+    EXPECT_EQ(values, sorted);
+}
+
+}  // namespace
+
+int main(int argc, char **argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
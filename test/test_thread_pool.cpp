@@ -0,0 +1,187 @@
+#include <atomic>
+#include <numeric>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+#include "simple_graph/thread_pool.hpp"
+
+namespace {
+
+TEST(TaskDequeTest, test_owner)
+{
+    simple_graph::detail::TaskDeque deque;
+    std::vector<simple_graph::detail::LoopTask> tasks(3);
+    int tag = 0;
+    EXPECT_TRUE(deque.empty());
+    EXPECT_EQ(nullptr, deque.pop());
+
+    std::int64_t base = deque.bottom();
+    for (auto &task : tasks) {
+        EXPECT_TRUE(deque.push(&task, &tag));
+    }
+    EXPECT_TRUE(deque.has_above(base));
+
+    /// Owner takes the latest task, thieves the oldest one.
+    EXPECT_EQ(&tasks[2], deque.pop());
+    EXPECT_EQ(nullptr, deque.steal(&base));
+    EXPECT_EQ(&tasks[0], deque.steal(&tag));
+    EXPECT_EQ(&tasks[1], deque.steal(nullptr));
+    EXPECT_EQ(nullptr, deque.pop());
+    EXPECT_FALSE(deque.has_above(base));
+    EXPECT_TRUE(deque.empty());
+}
+
+TEST(TaskDequeTest, test_capacity)
+{
+    simple_graph::detail::TaskDeque deque;
+    simple_graph::detail::LoopTask task;
+    for (std::int64_t i = 0; i < simple_graph::detail::TaskDeque::capacity; ++i) {
+        EXPECT_TRUE(deque.push(&task, nullptr));
+    }
+    EXPECT_FALSE(deque.push(&task, nullptr));
+    EXPECT_EQ(&task, deque.steal(nullptr));
+    EXPECT_TRUE(deque.push(&task, nullptr));
+}
+
+TEST(TaskDequeTest, test_concurrent_steal)
+{
+    simple_graph::detail::TaskDeque deque;
+    const int n = 100000;
+    std::vector<simple_graph::detail::LoopTask> tasks(n);
+    std::vector<std::atomic<int>> taken(n);
+    std::atomic<bool> done(false);
+
+    auto take = [&tasks, &taken](simple_graph::detail::LoopTask *task) {
+        ++taken[task - tasks.data()];
+    };
+    std::vector<std::thread> thieves;
+    for (int i = 0; i < 3; ++i) {
+        thieves.emplace_back([&deque, &done, &take] {
+            while (!done || !deque.empty()) {
+                if (auto *task = deque.steal(nullptr)) {
+                    take(task);
+                }
+            }
+        });
+    }
+
+    for (int i = 0; i < n; ++i) {
+        while (!deque.push(&tasks[i], nullptr)) {
+            std::this_thread::yield();
+        }
+        if (i % 3 == 0) {
+            if (auto *task = deque.pop()) {
+                take(task);
+            }
+        }
+    }
+    while (auto *task = deque.pop()) {
+        take(task);
+    }
+    done = true;
+    for (auto &t : thieves) {
+        t.join();
+    }
+
+    /// Every task is taken exactly once.
+    for (int i = 0; i < n; ++i) {
+        ASSERT_EQ(1, taken[i]) << i;
+    }
+}
+
+TEST(ThreadPoolTest, test_parallel_for)
+{
+    for (size_t threads : {1, 2, 4}) {
+        simple_graph::ThreadPool pool(threads);
+        EXPECT_EQ(threads, pool.size());
+
+        for (size_t grain : {0, 1, 7, 5000}) {
+            std::vector<int> hits(1000, 0);
+            std::vector<std::atomic<int>> busy(pool.size());
+            pool.parallel_for(0, hits.size(), [&hits, &busy](size_t worker, size_t idx) {
+                /// No two concurrent calls share a worker.
+                EXPECT_EQ(0, busy[worker]++);
+                ++hits[idx];
+                --busy[worker];
+            }, grain);
+            EXPECT_EQ(std::vector<int>(1000, 1), hits) << threads << " threads, grain " << grain;
+        }
+
+        /// Pool is reused by the next loop.
+        std::atomic<size_t> sum(0);
+        pool.parallel_for(10, 110, [&sum](size_t, size_t idx) { sum += idx; });
+        EXPECT_EQ(5950, sum);
+        pool.parallel_for(5, 5, [](size_t, size_t) { FAIL(); });
+    }
+}
+
+TEST(ThreadPoolTest, test_nested)
+{
+    simple_graph::ThreadPool pool(4);
+    std::vector<std::atomic<int>> hits(100 * 100);
+    pool.parallel_for(0, 100, [&pool, &hits](size_t, size_t i) {
+        pool.parallel_for(0, 100, [&hits, i](size_t, size_t j) {
+            ++hits[i * 100 + j];
+        });
+    }, 1);
+    for (const auto &h : hits) {
+        ASSERT_EQ(1, h);
+    }
+}
+
+TEST(ThreadPoolTest, test_exception)
+{
+    simple_graph::ThreadPool pool(3);
+    std::atomic<int> calls(0);
+    EXPECT_THROW(pool.parallel_for(0, 100000, [&calls](size_t, size_t idx) {
+        ++calls;
+        if (idx == 10) {
+            throw std::runtime_error("failed");
+        }
+    }, 1), std::runtime_error);
+    EXPECT_GT(100000, calls);
+
+    /// Pool still works after a failed loop.
+    calls = 0;
+    pool.parallel_for(0, 10, [&calls](size_t, size_t) { ++calls; });
+    EXPECT_EQ(10, calls);
+}
+
+TEST(ThreadPoolTest, test_concurrent_callers)
+{
+    simple_graph::ThreadPool pool(2);
+    std::atomic<int> calls(0);
+    std::vector<std::thread> callers;
+    for (int i = 0; i < 4; ++i) {
+        callers.emplace_back([&pool, &calls] {
+            for (int j = 0; j < 50; ++j) {
+                pool.parallel_for(0, 10, [&calls](size_t, size_t) { ++calls; }, 1);
+            }
+        });
+    }
+    for (auto &t : callers) {
+        t.join();
+    }
+    EXPECT_EQ(4 * 50 * 10, calls);
+}
+
+TEST(ThreadPoolTest, test_shared)
+{
+    simple_graph::ThreadPool &pool = simple_graph::ThreadPool::shared();
+    EXPECT_EQ(&pool, &simple_graph::ThreadPool::shared());
+    EXPECT_LE(1, pool.size());
+
+    std::vector<size_t> values(10000, 1);
+    std::atomic<size_t> sum(0);
+    pool.parallel_for(0, values.size(), [&values, &sum](size_t, size_t idx) { sum += values[idx]; });
+    EXPECT_EQ(10000, sum);
+}
+
+}  // namespace
+
+int main(int argc, char **argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -70,6 +70,53 @@ TEST_F(ListGraphUndirectedTest, test_rm_vertex)
     EXPECT_EQ(0, undirected_graph_empty.vertex_num());
 }
 
+TEST_F(ListGraphUndirectedTest, test_rm_vertices)
+{
+    undirected_graph.add_edge(simple_graph::Edge<int, int>(2, 4, 0, 11));
+    undirected_graph.add_edge(simple_graph::Edge<int, int>(4, 6, 0, 12));
+    undirected_graph.add_edge(simple_graph::Edge<int, int>(6, 23, 0, 13));
+    undirected_graph.add_edge(simple_graph::Edge<int, int>(23, 2, 0, 14));
+    undirected_graph.add_edge(simple_graph::Edge<int, int>(6, 6, 0, 15));
+
+    undirected_graph.rm_vertices({6, 23});
+    EXPECT_EQ(2, undirected_graph.vertex_num());
+    EXPECT_EQ(1, undirected_graph.edge_num());
+    EXPECT_EQ(11, undirected_graph.edge(4, 2).weight());
+    EXPECT_EQ(std::set<vertex_index_t>({2}), undirected_graph.outbounds(4, 0));
+    EXPECT_EQ(std::set<vertex_index_t>({4}), undirected_graph.outbounds(2, 0));
+    EXPECT_TRUE(undirected_graph.out_neighbours(6, 1).empty());
+}
+
+TEST_F(ListGraphUndirectedTest, test_readd_vertex)
+{
+    undirected_graph.add_edge(simple_graph::Edge<int, int>(2, 4, 0, 11));
+    undirected_graph.add_edge(simple_graph::Edge<int, int>(4, 6, 0, 12));
+    undirected_graph.add_edge(simple_graph::Edge<int, int>(6, 23, 0, 13));
+
+    /// Existing vertex keeps its data and edges.
+    undirected_graph.add_vertex(simple_graph::Vertex<char>(4, 'x'));
+    undirected_graph.add_vertex(simple_graph::Vertex<char>(6, 'y'));
+    EXPECT_EQ(4, undirected_graph.vertex_num());
+    EXPECT_EQ(3, undirected_graph.edge_num());
+    EXPECT_EQ('b', undirected_graph.vertex(4).data());
+    EXPECT_EQ(std::set<vertex_index_t>({4}), undirected_graph.outbounds(2, 0));
+    EXPECT_EQ(12, undirected_graph.edge(4, 6).weight());
+
+    /// Edges of re-added vertices are removed with them.
+    undirected_graph.rm_vertex(4);
+    EXPECT_EQ(1, undirected_graph.edge_num());
+    EXPECT_EQ(std::set<vertex_index_t>(), undirected_graph.outbounds(2, 0));
+    undirected_graph.rm_vertices({6});
+    EXPECT_EQ(0, undirected_graph.edge_num());
+    EXPECT_EQ(undirected_graph.edges().begin(), undirected_graph.edges().end());
+    EXPECT_EQ(std::set<vertex_index_t>(), undirected_graph.outbounds(23, 0));
+
+    std::vector<vertex_index_t> path;
+    EXPECT_FALSE(simple_graph::bfs(undirected_graph, 2, [](char c) { return c == 'd'; }, &path));
+    undirected_graph.add_edge(simple_graph::Edge<int, int>(2, 23, 0, 14));
+    EXPECT_EQ(1, undirected_graph.edge_num());
+}
+
 TEST_F(ListGraphUndirectedTest, test_get_outbounds)
 {
     ASSERT_EQ(4, undirected_graph.vertex_num());
@@ -156,6 +203,44 @@ TEST_F(ListGraphUndirectedTest, test_add_edge_descending)
     EXPECT_EQ(3, i);
 }
 
+TEST_F(ListGraphUndirectedTest, test_filter_edge)
+{
+    undirected_graph.add_edge(simple_graph::Edge<int, int>(2, 4, 0, 11));
+    undirected_graph.add_edge(simple_graph::Edge<int, int>(4, 6, 0, 12));
+
+    ASSERT_TRUE(undirected_graph.filter_edge(simple_graph::Edge<int, int>(6, 4, 0)));
+
+    /// Filtered edge is hidden in both directions.
+    EXPECT_EQ(std::set<vertex_index_t>({2}), undirected_graph.outbounds(4, 0));
+    EXPECT_EQ(0, undirected_graph.outbounds(6, 0).size());
+    EXPECT_EQ(std::set<vertex_index_t>({2}), undirected_graph.inbounds(4));
+    EXPECT_EQ(std::set<vertex_index_t>({2, 6}), undirected_graph.outbounds(4, 1));
+
+    ASSERT_TRUE(undirected_graph.restore_edge(simple_graph::Edge<int, int>(4, 6, 0)));
+    EXPECT_EQ(std::set<vertex_index_t>({4}), undirected_graph.outbounds(6, 0));
+}
+
+TEST_F(ListGraphUndirectedTest, test_add_edges)
+{
+    undirected_graph.add_edge(simple_graph::Edge<int, int>(2, 4, 0, 1));
+
+    undirected_graph.add_edges({
+        simple_graph::Edge<int, int>(4, 2, 0, 7),
+        simple_graph::Edge<int, int>(23, 6, 0, 3),
+        simple_graph::Edge<int, int>(6, 23, 0, 9),
+        simple_graph::Edge<int, int>(6, 6, 0, 5),
+        simple_graph::Edge<int, int>(2, 23, 0, 4),
+    });
+
+    EXPECT_EQ(4, undirected_graph.edge_num());
+    EXPECT_EQ(1, undirected_graph.edge(4, 2).weight());
+    EXPECT_EQ(3, undirected_graph.edge(6, 23).weight());
+    EXPECT_EQ(5, undirected_graph.edge(6, 6).weight());
+    EXPECT_EQ(std::set<vertex_index_t>({4, 23}), undirected_graph.outbounds(2, 0));
+    EXPECT_EQ(std::set<vertex_index_t>({6, 23}), undirected_graph.outbounds(6, 0));
+    EXPECT_EQ(std::set<vertex_index_t>({2, 6}), undirected_graph.inbounds(23));
+}
+
 }  // namespace
 
 int main(int argc, char **argv)
@@ -0,0 +1,91 @@
+#include <map>
+#include <gtest/gtest.h>
+#include "simple_graph/list_graph.hpp"
+#include "simple_graph/vertex_map.hpp"
+#include "simple_graph/algorithm/dijkstra.hpp"
+
+namespace {
+
+using simple_graph::vertex_index_t;
+
+template<typename M>
+class VertexMapTest : public ::testing::Test {
+protected:
+    M map;
+};
+
+using VertexMapTypes = ::testing::Types<simple_graph::SparseVertexMap<int>, simple_graph::DenseVertexMap<int>>;
+TYPED_TEST_SUITE(VertexMapTest, VertexMapTypes);
+
+TYPED_TEST(VertexMapTest, test_insert_erase)
+{
+    auto &map = this->map;
+    EXPECT_EQ(0, map.size());
+    EXPECT_FALSE(map.contains(3));
+    EXPECT_EQ(nullptr, map.find(3));
+    EXPECT_THROW(map.at(3), std::out_of_range);
+
+    EXPECT_TRUE(map.emplace(3, 30));
+    EXPECT_FALSE(map.emplace(3, 31));
+    EXPECT_EQ(30, map.at(3));
+    map[7] = 70;
+    ++map[7];
+    EXPECT_EQ(71, *map.find(7));
+    EXPECT_EQ(2, map.size());
+
+    std::map<vertex_index_t, int> items;
+    for (const auto &it : map) {
+        items[it.first] = it.second;
+    }
+    EXPECT_EQ((std::map<vertex_index_t, int>{{3, 30}, {7, 71}}), items);
+
+    map.erase(3);
+    map.erase(4);
+    EXPECT_FALSE(map.contains(3));
+    EXPECT_EQ(1, map.size());
+
+    /// Erased vertex may be added again.
+    EXPECT_TRUE(map.emplace(3, 32));
+    EXPECT_EQ(32, map.at(3));
+}
+
+TEST(DenseListGraphTest, test_same_as_sparse)
+{
+    simple_graph::ListGraph<true, int, int, int> sparse;
+    simple_graph::ListGraph<true, int, int, int, true> dense;
+    for (int i = 0; i < 50; ++i) {
+        sparse.add_vertex(simple_graph::Vertex<int>(i, i));
+        dense.add_vertex(simple_graph::Vertex<int>(i, i));
+    }
+    for (int i = 0; i < 50; ++i) {
+        for (int j : {i + 1, i * 3 % 50, i * 7 % 50}) {
+            if ((j < 50) && (j != i)) {
+                sparse.add_edge(simple_graph::Edge<int, int>(i, j, 0, (i + j) % 11 + 1));
+                dense.add_edge(simple_graph::Edge<int, int>(i, j, 0, (i + j) % 11 + 1));
+            }
+        }
+    }
+    sparse.rm_vertex(25);
+    dense.rm_vertex(25);
+    EXPECT_EQ(sparse.vertex_num(), dense.vertex_num());
+    EXPECT_EQ(sparse.edge_num(), dense.edge_num());
+    EXPECT_THROW(dense.vertex(25), std::out_of_range);
+    EXPECT_THROW(dense.vertex(-3), std::out_of_range);
+    EXPECT_THROW(dense.add_vertex(simple_graph::Vertex<int>(-3, 0)), std::out_of_range);
+    EXPECT_TRUE(dense.out_neighbours(100, 0).empty());
+
+    std::vector<int> sparse_distance;
+    std::vector<int> dense_distance;
+    std::vector<vertex_index_t> predecessor;
+    ASSERT_TRUE(simple_graph::dijkstra(sparse, 0, &sparse_distance, &predecessor));
+    ASSERT_TRUE(simple_graph::dijkstra(dense, 0, &dense_distance, &predecessor));
+    EXPECT_EQ(sparse_distance, dense_distance);
+}
+
+}  // namespace
+
+int main(int argc, char **argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}